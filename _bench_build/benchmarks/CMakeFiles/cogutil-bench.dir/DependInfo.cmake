@@ -0,0 +1,26 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/benchmarks/cacheBench.cc" "benchmarks/CMakeFiles/cogutil-bench.dir/cacheBench.cc.o" "gcc" "benchmarks/CMakeFiles/cogutil-bench.dir/cacheBench.cc.o.d"
+  "/root/repo/benchmarks/distanceBench.cc" "benchmarks/CMakeFiles/cogutil-bench.dir/distanceBench.cc.o" "gcc" "benchmarks/CMakeFiles/cogutil-bench.dir/distanceBench.cc.o.d"
+  "/root/repo/benchmarks/ioBench.cc" "benchmarks/CMakeFiles/cogutil-bench.dir/ioBench.cc.o" "gcc" "benchmarks/CMakeFiles/cogutil-bench.dir/ioBench.cc.o.d"
+  "/root/repo/benchmarks/logBench.cc" "benchmarks/CMakeFiles/cogutil-bench.dir/logBench.cc.o" "gcc" "benchmarks/CMakeFiles/cogutil-bench.dir/logBench.cc.o.d"
+  "/root/repo/benchmarks/parallelBench.cc" "benchmarks/CMakeFiles/cogutil-bench.dir/parallelBench.cc.o" "gcc" "benchmarks/CMakeFiles/cogutil-bench.dir/parallelBench.cc.o.d"
+  "/root/repo/benchmarks/randomBench.cc" "benchmarks/CMakeFiles/cogutil-bench.dir/randomBench.cc.o" "gcc" "benchmarks/CMakeFiles/cogutil-bench.dir/randomBench.cc.o.d"
+  "/root/repo/benchmarks/treeBench.cc" "benchmarks/CMakeFiles/cogutil-bench.dir/treeBench.cc.o" "gcc" "benchmarks/CMakeFiles/cogutil-bench.dir/treeBench.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_bench_build/opencog/util/CMakeFiles/cogutil.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,23 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/cogutil-bench.dir/cacheBench.cc.o"
+  "CMakeFiles/cogutil-bench.dir/cacheBench.cc.o.d"
+  "CMakeFiles/cogutil-bench.dir/distanceBench.cc.o"
+  "CMakeFiles/cogutil-bench.dir/distanceBench.cc.o.d"
+  "CMakeFiles/cogutil-bench.dir/ioBench.cc.o"
+  "CMakeFiles/cogutil-bench.dir/ioBench.cc.o.d"
+  "CMakeFiles/cogutil-bench.dir/logBench.cc.o"
+  "CMakeFiles/cogutil-bench.dir/logBench.cc.o.d"
+  "CMakeFiles/cogutil-bench.dir/parallelBench.cc.o"
+  "CMakeFiles/cogutil-bench.dir/parallelBench.cc.o.d"
+  "CMakeFiles/cogutil-bench.dir/randomBench.cc.o"
+  "CMakeFiles/cogutil-bench.dir/randomBench.cc.o.d"
+  "CMakeFiles/cogutil-bench.dir/treeBench.cc.o"
+  "CMakeFiles/cogutil-bench.dir/treeBench.cc.o.d"
+  "cogutil-bench"
+  "cogutil-bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cogutil-bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,50 @@
+
+####### Expanded from @PACKAGE_INIT@ by configure_package_config_file() #######
+####### Any changes to this file will be overwritten by the next CMake run ####
+####### The input file was CogUtilConfig.cmake.in                            ########
+
+get_filename_component(PACKAGE_PREFIX_DIR "${CMAKE_CURRENT_LIST_DIR}/../" ABSOLUTE)
+
+macro(set_and_check _var _file)
+  set(${_var} "${_file}")
+  if(NOT EXISTS "${_file}")
+    message(FATAL_ERROR "File or directory ${_file} referenced by variable ${_var} does not exist !")
+  endif()
+endmacro()
+
+macro(check_required_components _NAME)
+  foreach(comp ${${_NAME}_FIND_COMPONENTS})
+    if(NOT ${_NAME}_${comp}_FOUND)
+      if(${_NAME}_FIND_REQUIRED_${comp})
+        set(${_NAME}_FOUND FALSE)
+      endif()
+    endif()
+  endforeach()
+endmacro()
+
+####################################################################################
+set(COGUTIL_VERSION "2.0.3")
+
+set(COGUTIL_INCLUDE_DIR "/usr/local/include")
+set(COGUTIL_DATA_DIR   "/usr/local/share/opencog")
+set(COGUTIL_LIBRARY "/usr/local/lib/opencog/libcogutil.so")
+
+# oc_omp.h enables the parallelism cogutil was built with, see
+# oc_omp_config.h, so the code including it must be compiled and linked
+# with OpenMP (libstdc++ parallel mode) and TBB (C++17 execution
+# policies) as the library was. Both are added to COGUTIL_LIBRARY, the
+# OpenMP target bringing its compile flags (-fopenmp).
+set(COGUTIL_PARALLEL_STL_LIBRARIES "OpenMP::OpenMP_CXX;TBB::tbb")
+include(CMakeFindDependencyMacro)
+list(FIND COGUTIL_PARALLEL_STL_LIBRARIES OpenMP::OpenMP_CXX _cogutil_omp)
+if (NOT _cogutil_omp EQUAL -1)
+	find_dependency(OpenMP)
+endif ()
+list(FIND COGUTIL_PARALLEL_STL_LIBRARIES TBB::tbb _cogutil_tbb)
+if (NOT _cogutil_tbb EQUAL -1)
+	find_dependency(TBB CONFIG)
+endif ()
+list(APPEND COGUTIL_LIBRARY ${COGUTIL_PARALLEL_STL_LIBRARIES})
+
+set(COGUTIL_FOUND 1)
+
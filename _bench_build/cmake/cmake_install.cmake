@@ -0,0 +1,100 @@
+# Install script for directory: /root/repo/cmake
+
+# Set the install prefix
+if(NOT DEFINED CMAKE_INSTALL_PREFIX)
+  set(CMAKE_INSTALL_PREFIX "/usr/local")
+endif()
+string(REGEX REPLACE "/$" "" CMAKE_INSTALL_PREFIX "${CMAKE_INSTALL_PREFIX}")
+
+# Set the install configuration name.
+if(NOT DEFINED CMAKE_INSTALL_CONFIG_NAME)
+  if(BUILD_TYPE)
+    string(REGEX REPLACE "^[^A-Za-z0-9_]+" ""
+           CMAKE_INSTALL_CONFIG_NAME "${BUILD_TYPE}")
+  else()
+    set(CMAKE_INSTALL_CONFIG_NAME "Release")
+  endif()
+  message(STATUS "Install configuration: \"${CMAKE_INSTALL_CONFIG_NAME}\"")
+endif()
+
+# Set the component getting installed.
+if(NOT CMAKE_INSTALL_COMPONENT)
+  if(COMPONENT)
+    message(STATUS "Install component: \"${COMPONENT}\"")
+    set(CMAKE_INSTALL_COMPONENT "${COMPONENT}")
+  else()
+    set(CMAKE_INSTALL_COMPONENT)
+  endif()
+endif()
+
+# Install shared libraries without execute permission?
+if(NOT DEFINED CMAKE_INSTALL_SO_NO_EXE)
+  set(CMAKE_INSTALL_SO_NO_EXE "1")
+endif()
+
+# Is this installation the result of a crosscompile?
+if(NOT DEFINED CMAKE_CROSSCOMPILING)
+  set(CMAKE_CROSSCOMPILING "FALSE")
+endif()
+
+# Set default install directory permissions.
+if(NOT DEFINED CMAKE_OBJDUMP)
+  set(CMAKE_OBJDUMP "/usr/bin/objdump")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  list(APPEND CMAKE_ABSOLUTE_DESTINATION_FILES
+   "/usr/local/share/opencog/cmake/AddCxxtest.cmake;/usr/local/share/opencog/cmake/FindBFD.cmake;/usr/local/share/opencog/cmake/Findcpprest.cmake;/usr/local/share/opencog/cmake/FindCxxtest.cmake;/usr/local/share/opencog/cmake/FindCython.cmake;/usr/local/share/opencog/cmake/FindFolly.cmake;/usr/local/share/opencog/cmake/FindGHC.cmake;/usr/local/share/opencog/cmake/FindGTK3.cmake;/usr/local/share/opencog/cmake/FindGuile.cmake;/usr/local/share/opencog/cmake/FindHyperTable.cmake;/usr/local/share/opencog/cmake/FindIberty.cmake;/usr/local/share/opencog/cmake/FindLibGearman.cmake;/usr/local/share/opencog/cmake/FindLinkGrammar.cmake;/usr/local/share/opencog/cmake/FindMOSES.cmake;/usr/local/share/opencog/cmake/FindMsgPack.cmake;/usr/local/share/opencog/cmake/FindOCaml.cmake;/usr/local/share/opencog/cmake/FindOctomap.cmake;/usr/local/share/opencog/cmake/FindPGSQL.cmake;/usr/local/share/opencog/cmake/FindPthreads.cmake;/usr/local/share/opencog/cmake/FindRocksDB.cmake;/usr/local/share/opencog/cmake/FindSIGAR.cmake;/usr/local/share/opencog/cmake/FindStack.cmake;/usr/local/share/opencog/cmake/FindSTLPort.cmake;/usr/local/share/opencog/cmake/FindTBB.cmake;/usr/local/share/opencog/cmake/FindUUID.cmake;/usr/local/share/opencog/cmake/FindVALGRIND.cmake;/usr/local/share/opencog/cmake/FindZMQ.cmake;/usr/local/share/opencog/cmake/OCamlDep.cmake;/usr/local/share/opencog/cmake/OpenCogFindPython.cmake;/usr/local/share/opencog/cmake/OpenCogFindGuile.cmake;/usr/local/share/opencog/cmake/OpenCogGccOptions.cmake;/usr/local/share/opencog/cmake/OpenCogInstallOptions.cmake;/usr/local/share/opencog/cmake/OpenCogLibOptions.cmake;/usr/local/share/opencog/cmake/Summary.cmake;/usr/local/share/opencog/cmake/UseOCaml.cmake;/usr/local/share/opencog/cmake/COPYING-CMAKE-SCRIPTS")
+  if(CMAKE_WARN_ON_ABSOLUTE_INSTALL_DESTINATION)
+    message(WARNING "ABSOLUTE path INSTALL DESTINATION : ${CMAKE_ABSOLUTE_DESTINATION_FILES}")
+  endif()
+  if(CMAKE_ERROR_ON_ABSOLUTE_INSTALL_DESTINATION)
+    message(FATAL_ERROR "ABSOLUTE path INSTALL DESTINATION forbidden (by caller): ${CMAKE_ABSOLUTE_DESTINATION_FILES}")
+  endif()
+  file(INSTALL DESTINATION "/usr/local/share/opencog/cmake" TYPE FILE MESSAGE_LAZY FILES
+    "/root/repo/cmake/AddCxxtest.cmake"
+    "/root/repo/cmake/FindBFD.cmake"
+    "/root/repo/cmake/Findcpprest.cmake"
+    "/root/repo/cmake/FindCxxtest.cmake"
+    "/root/repo/cmake/FindCython.cmake"
+    "/root/repo/cmake/FindFolly.cmake"
+    "/root/repo/cmake/FindGHC.cmake"
+    "/root/repo/cmake/FindGTK3.cmake"
+    "/root/repo/cmake/FindGuile.cmake"
+    "/root/repo/cmake/FindHyperTable.cmake"
+    "/root/repo/cmake/FindIberty.cmake"
+    "/root/repo/cmake/FindLibGearman.cmake"
+    "/root/repo/cmake/FindLinkGrammar.cmake"
+    "/root/repo/cmake/FindMOSES.cmake"
+    "/root/repo/cmake/FindMsgPack.cmake"
+    "/root/repo/cmake/FindOCaml.cmake"
+    "/root/repo/cmake/FindOctomap.cmake"
+    "/root/repo/cmake/FindPGSQL.cmake"
+    "/root/repo/cmake/FindPthreads.cmake"
+    "/root/repo/cmake/FindRocksDB.cmake"
+    "/root/repo/cmake/FindSIGAR.cmake"
+    "/root/repo/cmake/FindStack.cmake"
+    "/root/repo/cmake/FindSTLPort.cmake"
+    "/root/repo/cmake/FindTBB.cmake"
+    "/root/repo/cmake/FindUUID.cmake"
+    "/root/repo/cmake/FindVALGRIND.cmake"
+    "/root/repo/cmake/FindZMQ.cmake"
+    "/root/repo/cmake/OCamlDep.cmake"
+    "/root/repo/cmake/OpenCogFindPython.cmake"
+    "/root/repo/cmake/OpenCogFindGuile.cmake"
+    "/root/repo/cmake/OpenCogGccOptions.cmake"
+    "/root/repo/cmake/OpenCogInstallOptions.cmake"
+    "/root/repo/cmake/OpenCogLibOptions.cmake"
+    "/root/repo/cmake/Summary.cmake"
+    "/root/repo/cmake/UseOCaml.cmake"
+    "/root/repo/cmake/COPYING-CMAKE-SCRIPTS"
+    )
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib/cmake/CogUtil" TYPE FILE MESSAGE_LAZY FILES
+    "/root/repo/_bench_build/cmake/CogUtilConfigVersion.cmake"
+    "/root/repo/_bench_build/cmake/CogUtilConfig.cmake"
+    )
+endif()
+
@@ -0,0 +1,42 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/opencog/util/backtrace-symbols.c" "opencog/util/CMakeFiles/cogutil.dir/backtrace-symbols.c.o" "gcc" "opencog/util/CMakeFiles/cogutil.dir/backtrace-symbols.c.o.d"
+  "/root/repo/opencog/util/cluster.c" "opencog/util/CMakeFiles/cogutil.dir/cluster.c.o" "gcc" "opencog/util/CMakeFiles/cogutil.dir/cluster.c.o.d"
+  "/root/repo/opencog/util/Config.cc" "opencog/util/CMakeFiles/cogutil.dir/Config.cc.o" "gcc" "opencog/util/CMakeFiles/cogutil.dir/Config.cc.o.d"
+  "/root/repo/opencog/util/Logger.cc" "opencog/util/CMakeFiles/cogutil.dir/Logger.cc.o" "gcc" "opencog/util/CMakeFiles/cogutil.dir/Logger.cc.o.d"
+  "/root/repo/opencog/util/StringTokenizer.cc" "opencog/util/CMakeFiles/cogutil.dir/StringTokenizer.cc.o" "gcc" "opencog/util/CMakeFiles/cogutil.dir/StringTokenizer.cc.o.d"
+  "/root/repo/opencog/util/ansi.cc" "opencog/util/CMakeFiles/cogutil.dir/ansi.cc.o" "gcc" "opencog/util/CMakeFiles/cogutil.dir/ansi.cc.o.d"
+  "/root/repo/opencog/util/exceptions.cc" "opencog/util/CMakeFiles/cogutil.dir/exceptions.cc.o" "gcc" "opencog/util/CMakeFiles/cogutil.dir/exceptions.cc.o.d"
+  "/root/repo/opencog/util/files.cc" "opencog/util/CMakeFiles/cogutil.dir/files.cc.o" "gcc" "opencog/util/CMakeFiles/cogutil.dir/files.cc.o.d"
+  "/root/repo/opencog/util/lazy_normal_selector.cc" "opencog/util/CMakeFiles/cogutil.dir/lazy_normal_selector.cc.o" "gcc" "opencog/util/CMakeFiles/cogutil.dir/lazy_normal_selector.cc.o.d"
+  "/root/repo/opencog/util/lazy_random_selector.cc" "opencog/util/CMakeFiles/cogutil.dir/lazy_random_selector.cc.o" "gcc" "opencog/util/CMakeFiles/cogutil.dir/lazy_random_selector.cc.o.d"
+  "/root/repo/opencog/util/lazy_selector.cc" "opencog/util/CMakeFiles/cogutil.dir/lazy_selector.cc.o" "gcc" "opencog/util/CMakeFiles/cogutil.dir/lazy_selector.cc.o.d"
+  "/root/repo/opencog/util/log_prog_name.cc" "opencog/util/CMakeFiles/cogutil.dir/log_prog_name.cc.o" "gcc" "opencog/util/CMakeFiles/cogutil.dir/log_prog_name.cc.o.d"
+  "/root/repo/opencog/util/mem_usage.cc" "opencog/util/CMakeFiles/cogutil.dir/mem_usage.cc.o" "gcc" "opencog/util/CMakeFiles/cogutil.dir/mem_usage.cc.o.d"
+  "/root/repo/opencog/util/metrics.cc" "opencog/util/CMakeFiles/cogutil.dir/metrics.cc.o" "gcc" "opencog/util/CMakeFiles/cogutil.dir/metrics.cc.o.d"
+  "/root/repo/opencog/util/misc.cc" "opencog/util/CMakeFiles/cogutil.dir/misc.cc.o" "gcc" "opencog/util/CMakeFiles/cogutil.dir/misc.cc.o.d"
+  "/root/repo/opencog/util/mt19937ar.cc" "opencog/util/CMakeFiles/cogutil.dir/mt19937ar.cc.o" "gcc" "opencog/util/CMakeFiles/cogutil.dir/mt19937ar.cc.o.d"
+  "/root/repo/opencog/util/oc_assert.cc" "opencog/util/CMakeFiles/cogutil.dir/oc_assert.cc.o" "gcc" "opencog/util/CMakeFiles/cogutil.dir/oc_assert.cc.o.d"
+  "/root/repo/opencog/util/oc_omp.cc" "opencog/util/CMakeFiles/cogutil.dir/oc_omp.cc.o" "gcc" "opencog/util/CMakeFiles/cogutil.dir/oc_omp.cc.o.d"
+  "/root/repo/opencog/util/octime.cc" "opencog/util/CMakeFiles/cogutil.dir/octime.cc.o" "gcc" "opencog/util/CMakeFiles/cogutil.dir/octime.cc.o.d"
+  "/root/repo/opencog/util/perf_counters.cc" "opencog/util/CMakeFiles/cogutil.dir/perf_counters.cc.o" "gcc" "opencog/util/CMakeFiles/cogutil.dir/perf_counters.cc.o.d"
+  "/root/repo/opencog/util/platform.cc" "opencog/util/CMakeFiles/cogutil.dir/platform.cc.o" "gcc" "opencog/util/CMakeFiles/cogutil.dir/platform.cc.o.d"
+  "/root/repo/opencog/util/thread_placement.cc" "opencog/util/CMakeFiles/cogutil.dir/thread_placement.cc.o" "gcc" "opencog/util/CMakeFiles/cogutil.dir/thread_placement.cc.o.d"
+  "/root/repo/opencog/util/tracing.cc" "opencog/util/CMakeFiles/cogutil.dir/tracing.cc.o" "gcc" "opencog/util/CMakeFiles/cogutil.dir/tracing.cc.o.d"
+  "/root/repo/opencog/util/tree.cc" "opencog/util/CMakeFiles/cogutil.dir/tree.cc.o" "gcc" "opencog/util/CMakeFiles/cogutil.dir/tree.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
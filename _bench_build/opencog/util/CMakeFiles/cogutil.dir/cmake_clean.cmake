@@ -0,0 +1,57 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/cogutil.dir/Config.cc.o"
+  "CMakeFiles/cogutil.dir/Config.cc.o.d"
+  "CMakeFiles/cogutil.dir/Logger.cc.o"
+  "CMakeFiles/cogutil.dir/Logger.cc.o.d"
+  "CMakeFiles/cogutil.dir/StringTokenizer.cc.o"
+  "CMakeFiles/cogutil.dir/StringTokenizer.cc.o.d"
+  "CMakeFiles/cogutil.dir/ansi.cc.o"
+  "CMakeFiles/cogutil.dir/ansi.cc.o.d"
+  "CMakeFiles/cogutil.dir/backtrace-symbols.c.o"
+  "CMakeFiles/cogutil.dir/backtrace-symbols.c.o.d"
+  "CMakeFiles/cogutil.dir/cluster.c.o"
+  "CMakeFiles/cogutil.dir/cluster.c.o.d"
+  "CMakeFiles/cogutil.dir/exceptions.cc.o"
+  "CMakeFiles/cogutil.dir/exceptions.cc.o.d"
+  "CMakeFiles/cogutil.dir/files.cc.o"
+  "CMakeFiles/cogutil.dir/files.cc.o.d"
+  "CMakeFiles/cogutil.dir/lazy_normal_selector.cc.o"
+  "CMakeFiles/cogutil.dir/lazy_normal_selector.cc.o.d"
+  "CMakeFiles/cogutil.dir/lazy_random_selector.cc.o"
+  "CMakeFiles/cogutil.dir/lazy_random_selector.cc.o.d"
+  "CMakeFiles/cogutil.dir/lazy_selector.cc.o"
+  "CMakeFiles/cogutil.dir/lazy_selector.cc.o.d"
+  "CMakeFiles/cogutil.dir/log_prog_name.cc.o"
+  "CMakeFiles/cogutil.dir/log_prog_name.cc.o.d"
+  "CMakeFiles/cogutil.dir/mem_usage.cc.o"
+  "CMakeFiles/cogutil.dir/mem_usage.cc.o.d"
+  "CMakeFiles/cogutil.dir/metrics.cc.o"
+  "CMakeFiles/cogutil.dir/metrics.cc.o.d"
+  "CMakeFiles/cogutil.dir/misc.cc.o"
+  "CMakeFiles/cogutil.dir/misc.cc.o.d"
+  "CMakeFiles/cogutil.dir/mt19937ar.cc.o"
+  "CMakeFiles/cogutil.dir/mt19937ar.cc.o.d"
+  "CMakeFiles/cogutil.dir/oc_assert.cc.o"
+  "CMakeFiles/cogutil.dir/oc_assert.cc.o.d"
+  "CMakeFiles/cogutil.dir/oc_omp.cc.o"
+  "CMakeFiles/cogutil.dir/oc_omp.cc.o.d"
+  "CMakeFiles/cogutil.dir/octime.cc.o"
+  "CMakeFiles/cogutil.dir/octime.cc.o.d"
+  "CMakeFiles/cogutil.dir/perf_counters.cc.o"
+  "CMakeFiles/cogutil.dir/perf_counters.cc.o.d"
+  "CMakeFiles/cogutil.dir/platform.cc.o"
+  "CMakeFiles/cogutil.dir/platform.cc.o.d"
+  "CMakeFiles/cogutil.dir/thread_placement.cc.o"
+  "CMakeFiles/cogutil.dir/thread_placement.cc.o.d"
+  "CMakeFiles/cogutil.dir/tracing.cc.o"
+  "CMakeFiles/cogutil.dir/tracing.cc.o.d"
+  "CMakeFiles/cogutil.dir/tree.cc.o"
+  "CMakeFiles/cogutil.dir/tree.cc.o.d"
+  "libcogutil.pdb"
+  "libcogutil.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C CXX)
+  include(CMakeFiles/cogutil.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,140 @@
+# Install script for directory: /root/repo/opencog/util
+
+# Set the install prefix
+if(NOT DEFINED CMAKE_INSTALL_PREFIX)
+  set(CMAKE_INSTALL_PREFIX "/usr/local")
+endif()
+string(REGEX REPLACE "/$" "" CMAKE_INSTALL_PREFIX "${CMAKE_INSTALL_PREFIX}")
+
+# Set the install configuration name.
+if(NOT DEFINED CMAKE_INSTALL_CONFIG_NAME)
+  if(BUILD_TYPE)
+    string(REGEX REPLACE "^[^A-Za-z0-9_]+" ""
+           CMAKE_INSTALL_CONFIG_NAME "${BUILD_TYPE}")
+  else()
+    set(CMAKE_INSTALL_CONFIG_NAME "Release")
+  endif()
+  message(STATUS "Install configuration: \"${CMAKE_INSTALL_CONFIG_NAME}\"")
+endif()
+
+# Set the component getting installed.
+if(NOT CMAKE_INSTALL_COMPONENT)
+  if(COMPONENT)
+    message(STATUS "Install component: \"${COMPONENT}\"")
+    set(CMAKE_INSTALL_COMPONENT "${COMPONENT}")
+  else()
+    set(CMAKE_INSTALL_COMPONENT)
+  endif()
+endif()
+
+# Install shared libraries without execute permission?
+if(NOT DEFINED CMAKE_INSTALL_SO_NO_EXE)
+  set(CMAKE_INSTALL_SO_NO_EXE "1")
+endif()
+
+# Is this installation the result of a crosscompile?
+if(NOT DEFINED CMAKE_CROSSCOMPILING)
+  set(CMAKE_CROSSCOMPILING "FALSE")
+endif()
+
+# Set default install directory permissions.
+if(NOT DEFINED CMAKE_OBJDUMP)
+  set(CMAKE_OBJDUMP "/usr/bin/objdump")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/include/opencog/util" TYPE FILE MESSAGE_LAZY FILES
+    "/root/repo/opencog/util/ansi.h"
+    "/root/repo/opencog/util/algorithm.h"
+    "/root/repo/opencog/util/async_buffer.h"
+    "/root/repo/opencog/util/async_method_caller.h"
+    "/root/repo/opencog/util/backtrace-symbols.h"
+    "/root/repo/opencog/util/based_variant.h"
+    "/root/repo/opencog/util/bitset_set.h"
+    "/root/repo/opencog/util/cluster.h"
+    "/root/repo/opencog/util/cogutil.h"
+    "/root/repo/opencog/util/comprehension.h"
+    "/root/repo/opencog/util/Config.h"
+    "/root/repo/opencog/util/Counter.h"
+    "/root/repo/opencog/util/Cover_Tree.h"
+    "/root/repo/opencog/util/concurrent_queue.h"
+    "/root/repo/opencog/util/concurrent_set.h"
+    "/root/repo/opencog/util/concurrent_stack.h"
+    "/root/repo/opencog/util/digraph.h"
+    "/root/repo/opencog/util/dorepeat.h"
+    "/root/repo/opencog/util/empty_string.h"
+    "/root/repo/opencog/util/exceptions.h"
+    "/root/repo/opencog/util/files.h"
+    "/root/repo/opencog/util/functional.h"
+    "/root/repo/opencog/util/hashing.h"
+    "/root/repo/opencog/util/information.h"
+    "/root/repo/opencog/util/iostreamContainer.h"
+    "/root/repo/opencog/util/jaccard_index.h"
+    "/root/repo/opencog/util/KLD.h"
+    "/root/repo/opencog/util/lazy_normal_selector.h"
+    "/root/repo/opencog/util/lazy_random_selector.h"
+    "/root/repo/opencog/util/lazy_selector.h"
+    "/root/repo/opencog/util/log_prog_name.h"
+    "/root/repo/opencog/util/Logger.h"
+    "/root/repo/opencog/util/lru_cache.h"
+    "/root/repo/opencog/util/macros.h"
+    "/root/repo/opencog/util/minhash.h"
+    "/root/repo/opencog/util/MannWhitneyU.h"
+    "/root/repo/opencog/util/mem_usage.h"
+    "/root/repo/opencog/util/metrics.h"
+    "/root/repo/opencog/util/misc.h"
+    "/root/repo/opencog/util/mt19937ar.h"
+    "/root/repo/opencog/util/numeric.h"
+    "/root/repo/opencog/util/oc_assert.h"
+    "/root/repo/opencog/util/oc_omp.h"
+    "/root/repo/_bench_build/opencog/util/oc_omp_config.h"
+    "/root/repo/opencog/util/online_stats.h"
+    "/root/repo/opencog/util/octime.h"
+    "/root/repo/opencog/util/parallel_algorithm.h"
+    "/root/repo/opencog/util/perf_counters.h"
+    "/root/repo/opencog/util/platform.h"
+    "/root/repo/opencog/util/pool.h"
+    "/root/repo/opencog/util/RandGen.h"
+    "/root/repo/opencog/util/random.h"
+    "/root/repo/opencog/util/ranking.h"
+    "/root/repo/opencog/util/recent_val.h"
+    "/root/repo/opencog/util/selection.h"
+    "/root/repo/opencog/util/sigslot.h"
+    "/root/repo/opencog/util/sketches.h"
+    "/root/repo/opencog/util/StringTokenizer.h"
+    "/root/repo/opencog/util/thread_placement.h"
+    "/root/repo/opencog/util/tracing.h"
+    "/root/repo/opencog/util/tree.h"
+    "/root/repo/opencog/util/zipf.h"
+    )
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  if(EXISTS "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/opencog/libcogutil.so" AND
+     NOT IS_SYMLINK "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/opencog/libcogutil.so")
+    file(RPATH_CHECK
+         FILE "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/opencog/libcogutil.so"
+         RPATH "/usr/local/lib/opencog")
+  endif()
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib/opencog" TYPE SHARED_LIBRARY MESSAGE_LAZY FILES "/root/repo/_bench_build/opencog/util/libcogutil.so")
+  if(EXISTS "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/opencog/libcogutil.so" AND
+     NOT IS_SYMLINK "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/opencog/libcogutil.so")
+    file(RPATH_CHANGE
+         FILE "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/opencog/libcogutil.so"
+         OLD_RPATH "::::::::::::::::::::::"
+         NEW_RPATH "/usr/local/lib/opencog")
+    if(CMAKE_INSTALL_DO_STRIP)
+      execute_process(COMMAND "/usr/bin/strip" "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/opencog/libcogutil.so")
+    endif()
+  endif()
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+endif()
+
+if(NOT CMAKE_INSTALL_LOCAL_ONLY)
+  # Include the install script for each subdirectory.
+  include("/root/repo/_bench_build/opencog/util/boost_ext/cmake_install.cmake")
+
+endif()
+
@@ -0,0 +1,37 @@
+/*
+ * opencog/util/oc_omp_config.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Generated by CMake from oc_omp_config.h.in: the parallelism
+// cogutil was built with, so that the code including oc_omp.h uses
+// the same backends as the library, whatever its own build flags.
+
+#ifndef _OPENCOG_OC_OMP_CONFIG_H
+#define _OPENCOG_OC_OMP_CONFIG_H
+
+#ifndef HAVE_PARALLEL_STL
+#define HAVE_PARALLEL_STL 1
+#endif
+
+#ifndef HAVE_STD_EXECUTION
+#define HAVE_STD_EXECUTION 1
+#endif
+
+#endif // _OPENCOG_OC_OMP_CONFIG_H
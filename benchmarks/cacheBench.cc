@@ -0,0 +1,216 @@
+/*
+ * benchmarks/cacheBench.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Caches, concurrent queues and asynchronous writers
+
+#include <atomic>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <opencog/util/async_buffer.h>
+#include <opencog/util/async_method_caller.h>
+#include <opencog/util/concurrent_queue.h>
+#include <opencog/util/lru_cache.h>
+#include <opencog/util/mt19937ar.h>
+#include <opencog/util/thread_placement.h>
+
+#include "perfReport.h"
+
+using namespace opencog;
+
+namespace {
+
+struct square
+{
+    typedef int argument_type;
+    typedef int result_type;
+    int operator()(int x) const { return x * x; }
+};
+
+// Keys drawn uniformly in [0, range), so that a cache of size n has a
+// hit ratio of about n / range
+std::vector<int> random_keys(int range, size_t n = 1 << 16)
+{
+    MT19937RandGen rng(1);
+    std::vector<int> keys(n);
+    for (int& k : keys)
+        k = rng.randint(range);
+    return keys;
+}
+
+// Arguments: cache size, key range
+template<typename Cache>
+void BM_cache(benchmark::State& state)
+{
+    Cache cache(state.range(0), square());
+    std::vector<int> keys = random_keys(state.range(1));
+    size_t i = 0;
+    perf_report pr(state);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(cache(keys[i++ % keys.size()]));
+    state.SetItemsProcessed(state.iterations());
+    state.counters["hit_ratio"] =
+        (double)cache.get_hits() / (cache.get_hits() + cache.get_misses());
+}
+BENCHMARK_TEMPLATE(BM_cache, lru_cache<square>)
+    ->Args({1000, 1000})->Args({1000, 10000});
+BENCHMARK_TEMPLATE(BM_cache, lru_cache_threaded<square>)
+    ->Args({1000, 1000})->Args({1000, 10000});
+BENCHMARK_TEMPLATE(BM_cache, prr_cache<square>)
+    ->Args({1000, 1000})->Args({1000, 10000});
+BENCHMARK_TEMPLATE(BM_cache, prr_cache_threaded<square>)
+    ->Args({1000, 1000})->Args({1000, 10000});
+
+void BM_inf_cache(benchmark::State& state)
+{
+    inf_cache<square> cache{square()};
+    std::vector<int> keys = random_keys(state.range(0));
+    size_t i = 0;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(cache(keys[i++ % keys.size()]));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_inf_cache)->Arg(1000)->Arg(100000);
+
+// Shared by the threads of BM_lru_cache_threaded_contended
+lru_cache_threaded<square>* shared_cache = nullptr;
+
+void BM_lru_cache_threaded_contended(benchmark::State& state)
+{
+    if (state.thread_index() == 0)
+        shared_cache = new lru_cache_threaded<square>(1000, square());
+    std::vector<int> keys = random_keys(2000);
+    size_t i = state.thread_index();
+    for (auto _ : state)
+        benchmark::DoNotOptimize((*shared_cache)(keys[i++ % keys.size()]));
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        delete shared_cache;
+        shared_cache = nullptr;
+    }
+}
+BENCHMARK(BM_lru_cache_threaded_contended)->ThreadRange(1, 4)->UseRealTime();
+
+void BM_concurrent_queue_push_pop(benchmark::State& state)
+{
+    concurrent_queue<int> q;
+    for (auto _ : state) {
+        q.push(1);
+        benchmark::DoNotOptimize(q.value_pop());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_concurrent_queue_push_pop);
+
+// One consumer thread, state.threads() - 1 producers
+concurrent_queue<int>* shared_queue = nullptr;
+
+void BM_concurrent_queue_mpsc(benchmark::State& state)
+{
+    if (state.thread_index() == 0)
+        shared_queue = new concurrent_queue<int>();
+    for (auto _ : state) {
+        if (state.thread_index() == 0) {
+            int v;
+            shared_queue->try_get(v);
+        } else {
+            shared_queue->push(1);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        delete shared_queue;
+        shared_queue = nullptr;
+    }
+}
+BENCHMARK(BM_concurrent_queue_mpsc)->Threads(2)->Threads(4)->UseRealTime();
+
+struct counting_writer
+{
+    std::atomic<long> sum{0};
+    void write(const int& x) { sum += x; }
+};
+
+// Enqueue throughput, including the final drain. Argument: number of
+// writer threads (0 makes the writes synchronous)
+void BM_async_caller(benchmark::State& state)
+{
+    counting_writer w;
+    async_caller<counting_writer, int> ac(&w, &counting_writer::write,
+                                          state.range(0));
+    ac.set_watermarks(10000, 1000);
+    for (auto _ : state)
+        ac.enqueue(1);
+    ac.barrier();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_async_caller)->Arg(0)->Arg(1)->Arg(4)->UseRealTime();
+
+// Same for the de-duplicating buffer, with a given number of distinct
+// elements (second argument)
+void BM_async_buffer(benchmark::State& state)
+{
+    counting_writer w;
+    async_buffer<counting_writer, int> ab(&w, &counting_writer::write,
+                                          state.range(0));
+    ab.set_watermarks(10000, 1000);
+    int i = 0;
+    for (auto _ : state)
+        ab.insert(i++ % state.range(1));
+    ab.barrier();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_async_buffer)->Args({1, 100})->Args({4, 100})
+    ->Args({4, 1000000})->UseRealTime();
+
+// Write throughput of 4 writers depending on their placement: 0
+// anywhere, 1 spread over the NUMA nodes, 2 all pinned to the first
+// node. The second argument is the number of producer threads.
+void BM_async_caller_placement(benchmark::State& state)
+{
+    static counting_writer w;
+    static async_caller<counting_writer, int>* ac = nullptr;
+    if (state.thread_index() == 0) {
+        ac = new async_caller<counting_writer, int>(&w, &counting_writer::write, 4);
+        ac->set_watermarks(10000, 1000);
+        switch (state.range(0)) {
+        case 1:
+            ac->set_placement(thread_placement::spread());
+            break;
+        case 2:
+            ac->set_placement(thread_placement::pinned(numa_node_cpus(0)));
+            break;
+        }
+        state.counters["numa_nodes"] = numa_node_count();
+    }
+    for (auto _ : state)
+        ac->enqueue(1);
+    if (state.thread_index() == 0) {
+        ac->barrier();
+        delete ac;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_async_caller_placement)->Arg(0)->Arg(1)->Arg(2)
+    ->Threads(1)->Threads(4)->UseRealTime();
+
+} // namespace
@@ -0,0 +1,269 @@
+/*
+ * benchmarks/distanceBench.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Distances, divergences, statistical tests, sketches and clustering
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <opencog/util/bitset_set.h>
+#include <opencog/util/information.h>
+#include <opencog/util/jaccard_index.h>
+#include <opencog/util/KLD.h>
+#include <opencog/util/MannWhitneyU.h>
+#include <opencog/util/minhash.h>
+#include <opencog/util/mt19937ar.h>
+#include <opencog/util/sketches.h>
+
+#include "perfReport.h"
+
+extern "C" {
+#include <opencog/util/cluster.h>
+}
+
+using namespace opencog;
+
+namespace {
+
+std::vector<double> random_sample(size_t n, unsigned seed, double shift = 0)
+{
+    MT19937RandGen rng(seed);
+    std::vector<double> s(n);
+    for (double& v : s)
+        v = rng.randint(1000) / 10.0 + shift;
+    return s;
+}
+
+std::vector<double> sorted_sample(size_t n, unsigned seed, double shift = 0)
+{
+    std::vector<double> s = random_sample(n, seed, shift);
+    std::sort(s.begin(), s.end());
+    return s;
+}
+
+// Argument: size of both samples
+void BM_KLDS(benchmark::State& state)
+{
+    std::vector<double> p = sorted_sample(state.range(0), 1),
+        q = sorted_sample(state.range(0), 2, 5);
+    KLDS<double> klds(p);
+    Counter<double, double> q_counter(q);
+    perf_report pr(state);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(klds(q_counter));
+}
+BENCHMARK(BM_KLDS)->Arg(1000)->Arg(100000);
+
+void BM_FlatKLDS(benchmark::State& state)
+{
+    std::vector<double> p = sorted_sample(state.range(0), 1),
+        q = sorted_sample(state.range(0), 2, 5);
+    FlatKLDS<double> klds(p);
+    perf_report pr(state);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(klds(q));
+}
+BENCHMARK(BM_FlatKLDS)->Arg(1000)->Arg(100000);
+
+void BM_MannWhitneyU_counters(benchmark::State& state)
+{
+    Counter<double, double> c1(random_sample(state.range(0), 1)),
+        c2(random_sample(state.range(0), 2, 5));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(standardizedMannWhitneyU(c1, c2));
+}
+BENCHMARK(BM_MannWhitneyU_counters)->Arg(1000)->Arg(100000);
+
+void BM_MannWhitneyUTest(benchmark::State& state)
+{
+    std::vector<double> s1 = random_sample(state.range(0), 1),
+        s2 = random_sample(state.range(0), 2, 5);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(MannWhitneyUTest(s1, s2));
+}
+BENCHMARK(BM_MannWhitneyUTest)->Arg(1000)->Arg(100000);
+
+// Arguments: size of the distribution, approximate
+void BM_entropy(benchmark::State& state)
+{
+    std::vector<double> p = random_sample(state.range(0), 1);
+    double sum = 0;
+    for (double v : p)
+        sum += v;
+    for (double& v : p)
+        v /= sum;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(entropy(p, state.range(1)));
+    state.SetItemsProcessed(state.iterations() * p.size());
+}
+BENCHMARK(BM_entropy)->Args({4096, 0})->Args({4096, 1});
+
+void BM_jensen_shannon_divergence(benchmark::State& state)
+{
+    std::vector<double> p = random_sample(state.range(0), 1),
+        q = random_sample(state.range(0), 2);
+    double sp = 0, sq = 0;
+    for (size_t i = 0; i < p.size(); ++i) {
+        sp += p[i];
+        sq += q[i];
+    }
+    for (size_t i = 0; i < p.size(); ++i) {
+        p[i] /= sp;
+        q[i] /= sq;
+    }
+    for (auto _ : state)
+        benchmark::DoNotOptimize(
+            jensen_shannon_divergence(p, q, state.range(1)));
+    state.SetItemsProcessed(state.iterations() * p.size());
+}
+BENCHMARK(BM_jensen_shannon_divergence)->Args({4096, 0})->Args({4096, 1});
+
+// Random subset of [0, domain) with the given density (in percent)
+template<typename Set>
+Set random_set(size_t domain, int density, unsigned seed)
+{
+    MT19937RandGen rng(seed);
+    Set s;
+    for (size_t i = 0; i < domain; ++i)
+        if (rng.randint(100) < density)
+            s.insert(i);
+    return s;
+}
+
+// Arguments: domain size, density in percent
+template<typename Set>
+void BM_jaccard_index(benchmark::State& state)
+{
+    Set s1 = random_set<Set>(state.range(0), state.range(1), 1),
+        s2 = random_set<Set>(state.range(0), state.range(1), 2);
+    perf_report pr(state);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(jaccard_index(s1, s2));
+}
+BENCHMARK_TEMPLATE(BM_jaccard_index, std::set<size_t>)
+    ->Args({10000, 10})->Args({10000, 50});
+BENCHMARK_TEMPLATE(BM_jaccard_index, bitset_set)
+    ->Args({10000, 10})->Args({10000, 50});
+
+// Argument: set size
+void BM_minhash_signature(benchmark::State& state)
+{
+    minhash<size_t> mh(128);
+    std::set<size_t> s = random_set<std::set<size_t>>(state.range(0) * 2,
+                                                      50, 1);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(mh.signature(s));
+    state.SetItemsProcessed(state.iterations() * s.size());
+}
+BENCHMARK(BM_minhash_signature)->Arg(100)->Arg(10000);
+
+void BM_count_min_sketch_add(benchmark::State& state)
+{
+    count_min_sketch<unsigned> cms =
+        count_min_sketch<unsigned>::from_error(1e-4, 1e-3, state.range(0));
+    unsigned i = 0;
+    for (auto _ : state)
+        cms.add(i++ % 100000);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_count_min_sketch_add)->Arg(0)->Arg(1);
+
+void BM_hyperloglog_add(benchmark::State& state)
+{
+    hyperloglog<unsigned> hll(14);
+    unsigned i = 0;
+    for (auto _ : state)
+        hll.add(i++);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_hyperloglog_add);
+
+void BM_space_saving_add(benchmark::State& state)
+{
+    space_saving<unsigned> ss(100);
+    MT19937RandGen rng(1);
+    std::vector<unsigned> keys(1 << 16);
+    for (unsigned& k : keys)
+        k = rng.randint(10000);
+    size_t i = 0;
+    for (auto _ : state)
+        ss.add(keys[i++ % keys.size()]);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_space_saving_add);
+
+// Rows of random data, in the ragged arrays of the C Clustering Library
+struct cluster_data
+{
+    cluster_data(int rows, int cols)
+        : values(rows, std::vector<double>(cols)),
+          ones(rows, std::vector<int>(cols, 1)), weight(cols, 1.0)
+    {
+        MT19937RandGen rng(1);
+        for (int r = 0; r < rows; ++r) {
+            for (double& v : values[r])
+                v = rng.randdouble() + r % 5;
+            data.push_back(values[r].data());
+            mask.push_back(ones[r].data());
+        }
+    }
+    std::vector<std::vector<double>> values;
+    std::vector<std::vector<int>> ones;
+    std::vector<double*> data;
+    std::vector<int*> mask;
+    std::vector<double> weight;
+};
+
+// Arguments: number of rows, number of columns
+void BM_distancematrix(benchmark::State& state)
+{
+    int rows = state.range(0), cols = state.range(1);
+    cluster_data cd(rows, cols);
+    for (auto _ : state) {
+        double** dm = distancematrix(rows, cols, cd.data.data(),
+                                     cd.mask.data(), cd.weight.data(),
+                                     'e', 0);
+        for (int i = 1; i < rows; ++i)
+            free(dm[i]);
+        free(dm);
+    }
+    state.SetItemsProcessed(state.iterations() * rows * (rows - 1) / 2);
+}
+BENCHMARK(BM_distancematrix)->Args({500, 20});
+
+void BM_kcluster(benchmark::State& state)
+{
+    int rows = state.range(0), cols = state.range(1);
+    cluster_data cd(rows, cols);
+    std::vector<int> clusterid(rows);
+    double error;
+    int ifound;
+    for (auto _ : state)
+        kcluster(5, rows, cols, cd.data.data(), cd.mask.data(),
+                 cd.weight.data(), 0, 10, 'a', 'e', clusterid.data(),
+                 &error, &ifound);
+}
+BENCHMARK(BM_kcluster)->Args({1000, 20});
+
+} // namespace
@@ -0,0 +1,190 @@
+/*
+ * benchmarks/ioBench.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// File reading and tokenizing
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include <unistd.h>
+
+#include <benchmark/benchmark.h>
+
+#include <opencog/util/files.h>
+#include <opencog/util/mt19937ar.h>
+#include <opencog/util/StringTokenizer.h>
+
+using namespace opencog;
+
+namespace {
+
+// Text of about 32MB, lines of 1 to 20 space-separated words, written
+// to a temporary file (in the page cache once read) on first use
+struct text_file
+{
+    text_file() : name("cogutil_bench_" + std::to_string(getpid()) + ".txt")
+    {
+        MT19937RandGen rng(1);
+        std::ostringstream oss;
+        while (oss.tellp() < (1 << 25)) {
+            for (int w = rng.randint(20); w >= 0; --w)
+                oss << "word" << rng.randint(10000) << (w ? " " : "\n");
+        }
+        content = oss.str();
+        std::ofstream(name) << content;
+    }
+    ~text_file() { unlink(name.c_str()); }
+
+    std::string name;
+    std::string content;
+};
+
+const text_file& text()
+{
+    static text_file tf;
+    return tf;
+}
+
+void BM_ifstream_read(benchmark::State& state)
+{
+    const text_file& tf = text();
+    for (auto _ : state) {
+        std::ifstream in(tf.name);
+        std::ostringstream oss;
+        oss << in.rdbuf();
+        benchmark::DoNotOptimize(oss.str().size());
+    }
+    state.SetBytesProcessed(state.iterations() * tf.content.size());
+}
+BENCHMARK(BM_ifstream_read)->UseRealTime();
+
+void BM_read_file(benchmark::State& state)
+{
+    const text_file& tf = text();
+    std::string dest;
+    for (auto _ : state)
+        read_file(tf.name, dest);
+    state.SetBytesProcessed(state.iterations() * tf.content.size());
+}
+BENCHMARK(BM_read_file)->UseRealTime();
+
+// Count the lines of a mapped file
+void BM_mapped_file(benchmark::State& state)
+{
+    const text_file& tf = text();
+    for (auto _ : state) {
+        mapped_file mf(tf.name);
+        benchmark::DoNotOptimize(
+            std::count(mf.data(), mf.data() + mf.size(), '\n'));
+    }
+    state.SetBytesProcessed(state.iterations() * tf.content.size());
+}
+BENCHMARK(BM_mapped_file)->UseRealTime();
+
+void BM_std_getline(benchmark::State& state)
+{
+    const text_file& tf = text();
+    for (auto _ : state) {
+        std::ifstream in(tf.name);
+        std::string line;
+        size_t n = 0;
+        while (std::getline(in, line))
+            ++n;
+        benchmark::DoNotOptimize(n);
+    }
+    state.SetBytesProcessed(state.iterations() * tf.content.size());
+}
+BENCHMARK(BM_std_getline)->UseRealTime();
+
+void BM_chunked_line_reader(benchmark::State& state)
+{
+    const text_file& tf = text();
+    for (auto _ : state) {
+        chunked_line_reader reader(tf.name);
+        std::string_view line;
+        size_t n = 0;
+        while (reader.getline(line))
+            ++n;
+        benchmark::DoNotOptimize(n);
+    }
+    state.SetBytesProcessed(state.iterations() * tf.content.size());
+}
+BENCHMARK(BM_chunked_line_reader)->UseRealTime();
+
+void BM_StringTokenizer(benchmark::State& state)
+{
+    const text_file& tf = text();
+    for (auto _ : state) {
+        StringTokenizer st(tf.content, " \n");
+        size_t n = 0;
+        while (not st.next_token().empty())
+            ++n;
+        benchmark::DoNotOptimize(n);
+    }
+    state.SetBytesProcessed(state.iterations() * tf.content.size());
+}
+BENCHMARK(BM_StringTokenizer);
+
+void BM_AltStringTokenizer(benchmark::State& state)
+{
+    const text_file& tf = text();
+    for (auto _ : state) {
+        AltStringTokenizer st(tf.content, " \n");
+        benchmark::DoNotOptimize(st.size());
+    }
+    state.SetBytesProcessed(state.iterations() * tf.content.size());
+}
+BENCHMARK(BM_AltStringTokenizer);
+
+void BM_StringViewTokenizer(benchmark::State& state)
+{
+    const text_file& tf = text();
+    for (auto _ : state) {
+        size_t n = 0;
+        for (std::string_view tok : StringViewTokenizer(tf.content, " \n")) {
+            benchmark::DoNotOptimize(tok.data());
+            ++n;
+        }
+        benchmark::DoNotOptimize(n);
+    }
+    state.SetBytesProcessed(state.iterations() * tf.content.size());
+}
+BENCHMARK(BM_StringViewTokenizer);
+
+// Delimiter strings, the first one absent from the text
+void BM_StringViewTokenizerStrings(benchmark::State& state)
+{
+    const text_file& tf = text();
+    std::vector<std::string_view> delims = {"@@", " ", "\n"};
+    for (auto _ : state) {
+        size_t n = 0;
+        for (std::string_view tok : StringViewTokenizer(tf.content, delims)) {
+            benchmark::DoNotOptimize(tok.data());
+            ++n;
+        }
+        benchmark::DoNotOptimize(n);
+    }
+    state.SetBytesProcessed(state.iterations() * tf.content.size());
+}
+BENCHMARK(BM_StringViewTokenizerStrings);
+
+} // namespace
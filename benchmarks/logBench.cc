@@ -0,0 +1,161 @@
+/*
+ * benchmarks/logBench.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Logging, tracing, metrics, performance counters and configuration
+// lookups
+
+#include <unistd.h>
+
+#include <benchmark/benchmark.h>
+
+#include <opencog/util/Config.h>
+#include <opencog/util/Logger.h>
+#include <opencog/util/metrics.h>
+#include <opencog/util/perf_counters.h>
+#include <opencog/util/tracing.h>
+
+using namespace opencog;
+
+namespace {
+
+// A message below the level of the logger, the common case of debug
+// statements left in the code
+void BM_logger_filtered(benchmark::State& state)
+{
+    Logger log("/dev/null", Logger::INFO, false);
+    for (auto _ : state)
+        log.debug("filtered message %d", 42);
+}
+BENCHMARK(BM_logger_filtered);
+
+// Argument: whether timestamps are printed
+void BM_logger_written(benchmark::State& state)
+{
+    std::string fname = "cogutil_bench_" + std::to_string(getpid()) + ".log";
+    {
+        Logger log(fname, Logger::INFO, state.range(0));
+        for (auto _ : state)
+            log.info("written message %d", 42);
+        log.flush();
+    }
+    unlink(fname.c_str());
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_logger_written)->Arg(0)->Arg(1)->UseRealTime();
+
+void BM_trace_span_disabled(benchmark::State& state)
+{
+    tracer().disable();
+    for (auto _ : state) {
+        OC_TRACE_SPAN("bench");
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_trace_span_disabled);
+
+void BM_trace_span_enabled(benchmark::State& state)
+{
+    tracer().enable();
+    for (auto _ : state) {
+        OC_TRACE_SPAN("bench");
+        benchmark::ClobberMemory();
+    }
+    tracer().disable();
+    tracer().clear();
+    state.counters["dropped"] = tracer().dropped();
+}
+BENCHMARK(BM_trace_span_enabled);
+
+// Spans recording the hardware counters, when available
+void BM_trace_span_perf(benchmark::State& state)
+{
+    tracer().enable();
+    tracer().enable_perf();
+    for (auto _ : state) {
+        OC_TRACE_SPAN("bench");
+        benchmark::ClobberMemory();
+    }
+    tracer().disable_perf();
+    tracer().disable();
+    tracer().clear();
+    state.counters["perf"] = perf_counters::supported();
+}
+BENCHMARK(BM_trace_span_perf);
+
+void BM_perf_counters_read(benchmark::State& state)
+{
+    perf_counters& pc = local_perf_counters();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(pc.read());
+    state.counters["perf"] = pc.available();
+}
+BENCHMARK(BM_perf_counters_read);
+
+void BM_counter_add(benchmark::State& state)
+{
+    counter& c = metrics().get_counter("bench.counter");
+    for (auto _ : state)
+        ++c;
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_counter_add)->ThreadRange(1, 4);
+
+// Baseline for BM_counter_add: a single shared atomic
+std::atomic<unsigned long> plain_counter(0);
+
+void BM_atomic_add(benchmark::State& state)
+{
+    for (auto _ : state)
+        ++plain_counter;
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_atomic_add)->ThreadRange(1, 4);
+
+void BM_histogram_record(benchmark::State& state)
+{
+    histogram& h = metrics().get_histogram("bench.histogram");
+    uint64_t v = 1;
+    for (auto _ : state)
+        h.record(v = v * 6364136223846793005ull + 1442695040888963407ull);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_histogram_record)->ThreadRange(1, 4);
+
+void BM_config_get_int(benchmark::State& state)
+{
+    Config cfg;
+    cfg.set("BENCH_INT", "42");
+    for (auto _ : state)
+        benchmark::DoNotOptimize(cfg.get_int("BENCH_INT"));
+}
+BENCHMARK(BM_config_get_int);
+
+void BM_config_param(benchmark::State& state)
+{
+    Config cfg;
+    cfg.set("BENCH_INT", "42");
+    config_param<int> p = cfg.param<int>("BENCH_INT", 0);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(p.get());
+}
+BENCHMARK(BM_config_param);
+
+} // namespace
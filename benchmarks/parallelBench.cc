@@ -0,0 +1,155 @@
+/*
+ * benchmarks/parallelBench.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// The parallel algorithms of oc_omp.h on each backend: the libstdc++
+// parallel mode, the C++17 execution policies and the thread pool,
+// against the serial algorithms. The arguments are the backend (in
+// the order of parallel_backend) and the number of threads.
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <opencog/util/mt19937ar.h>
+#include <opencog/util/oc_omp.h>
+
+using namespace opencog;
+
+namespace {
+
+const size_t N = 1 << 20;
+
+std::vector<double> random_sample(size_t n, unsigned seed)
+{
+    MT19937RandGen rng(seed);
+    std::vector<double> s(n);
+    for (double& v : s)
+        v = rng.randdouble();
+    return s;
+}
+
+// Set the backend and the number of threads of the benchmark for its
+// lifetime, return false (skipping it) if the backend is not available
+class parallel_setup
+{
+public:
+    explicit parallel_setup(benchmark::State& state)
+        : _backend(get_parallel_backend()), _num_threads(num_threads()),
+          _ok(parallel_backend_available((parallel_backend)state.range(0)))
+    {
+        if (not _ok) {
+            state.SkipWithError("backend not available");
+            return;
+        }
+        set_parallel_backend((parallel_backend)state.range(0));
+        setting_omp(state.range(1), 1000);
+        state.SetLabel(to_string(get_parallel_backend()));
+    }
+    ~parallel_setup()
+    {
+        set_parallel_backend(_backend);
+        setting_omp(_num_threads, 1000);
+    }
+    explicit operator bool() const { return _ok; }
+
+private:
+    parallel_backend _backend;
+    unsigned _num_threads;
+    bool _ok;
+};
+
+void backend_args(benchmark::internal::Benchmark* b)
+{
+    unsigned nt = std::max(2U, std::thread::hardware_concurrency());
+    for (int pb = 0; pb < 4; ++pb)
+        b->Args({pb, pb == 0 ? 1 : nt});
+}
+
+void BM_parallel_sort(benchmark::State& state)
+{
+    parallel_setup ps(state);
+    if (not ps) return;
+    std::vector<double> s = random_sample(N, 1), v;
+    for (auto _ : state) {
+        state.PauseTiming();
+        v = s;
+        state.ResumeTiming();
+        parallel_sort(v.begin(), v.end());
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+BENCHMARK(BM_parallel_sort)->Apply(backend_args)->UseRealTime();
+
+void BM_parallel_transform(benchmark::State& state)
+{
+    parallel_setup ps(state);
+    if (not ps) return;
+    std::vector<double> s = random_sample(N, 1), v(N);
+    for (auto _ : state) {
+        parallel_transform(s.begin(), s.end(), v.begin(),
+                           [](double x) { return x * x + 1; });
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+BENCHMARK(BM_parallel_transform)->Apply(backend_args)->UseRealTime();
+
+void BM_parallel_for_each(benchmark::State& state)
+{
+    parallel_setup ps(state);
+    if (not ps) return;
+    std::vector<double> v = random_sample(N, 1);
+    for (auto _ : state) {
+        parallel_for_each(v.begin(), v.end(), [](double& x) { x *= 0.5; });
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+BENCHMARK(BM_parallel_for_each)->Apply(backend_args)->UseRealTime();
+
+void BM_parallel_reduce(benchmark::State& state)
+{
+    parallel_setup ps(state);
+    if (not ps) return;
+    std::vector<double> s = random_sample(N, 1);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(parallel_reduce(s.begin(), s.end(), 0.0));
+    state.SetItemsProcessed(state.iterations() * N);
+}
+BENCHMARK(BM_parallel_reduce)->Apply(backend_args)->UseRealTime();
+
+void BM_parallel_inclusive_scan(benchmark::State& state)
+{
+    parallel_setup ps(state);
+    if (not ps) return;
+    std::vector<double> s = random_sample(N, 1), v(N);
+    for (auto _ : state) {
+        parallel_inclusive_scan(s.begin(), s.end(), v.begin());
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+BENCHMARK(BM_parallel_inclusive_scan)->Apply(backend_args)->UseRealTime();
+
+} // namespace
@@ -0,0 +1,74 @@
+/*
+ * benchmarks/perfReport.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_BENCH_PERF_REPORT_H
+#define _OPENCOG_BENCH_PERF_REPORT_H
+
+#include <benchmark/benchmark.h>
+
+#include <opencog/util/perf_counters.h>
+
+namespace opencog
+{
+
+/**
+ * Report the hardware performance counters of a benchmark as user
+ * counters, averaged per iteration (cycles, instructions, cache and
+ * branch misses), plus the instructions per cycle. Declare it just
+ * before the timing loop, so that the setup is not counted:
+ *
+ *     perf_report pr(state);
+ *     for (auto _ : state)
+ *         ...
+ *
+ * Nothing is reported where the counters are not available.
+ */
+class perf_report
+{
+public:
+    explicit perf_report(benchmark::State& state)
+        : _state(state), _start(local_perf_counters().read()) {}
+
+    ~perf_report()
+    {
+        if (_start.empty())
+            return;
+        perf_counts pc = local_perf_counters().read() - _start;
+        for (unsigned e = 0; e < perf_counts::N_EVENTS; ++e) {
+            perf_counts::event ev = (perf_counts::event)e;
+            if (pc.has(ev))
+                _state.counters[perf_counts::name(ev)] =
+                    benchmark::Counter(pc[ev],
+                                       benchmark::Counter::kAvgIterations);
+        }
+        if (pc.ipc() > 0)
+            _state.counters["ipc"] =
+                benchmark::Counter(pc.ipc(), benchmark::Counter::kAvgThreads);
+    }
+
+private:
+    benchmark::State& _state;
+    perf_counts _start;
+};
+
+} // namespace opencog
+
+#endif // _OPENCOG_BENCH_PERF_REPORT_H
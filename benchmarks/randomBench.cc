@@ -0,0 +1,130 @@
+/*
+ * benchmarks/randomBench.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// Random generators, distributions and selection
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <opencog/util/lazy_random_selector.h>
+#include <opencog/util/mt19937ar.h>
+#include <opencog/util/selection.h>
+#include <opencog/util/zipf.h>
+
+using namespace opencog;
+
+namespace {
+
+void BM_randint(benchmark::State& state)
+{
+    MT19937RandGen rng(1);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(rng.randint(1000));
+}
+BENCHMARK(BM_randint);
+
+void BM_randdouble(benchmark::State& state)
+{
+    MT19937RandGen rng(1);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(rng.randdouble());
+}
+BENCHMARK(BM_randdouble);
+
+// Argument: size of the distribution
+void BM_rand_discrete(benchmark::State& state)
+{
+    MT19937RandGen rng(1);
+    std::vector<double> probs(state.range(0));
+    for (size_t i = 0; i < probs.size(); ++i)
+        probs[i] = 1.0 / (i + 1);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(rng.rand_discrete(probs));
+}
+BENCHMARK(BM_rand_discrete)->Arg(10)->Arg(1000);
+
+// Argument: number of items
+void BM_zipf(benchmark::State& state)
+{
+    MT19937RandGen rng(1);
+    zipf_distribution<> zipf(state.range(0), 1.1);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(zipf(rng));
+}
+BENCHMARK(BM_zipf)->Arg(1000)->Arg(1000000);
+
+void BM_zipf_table(benchmark::State& state)
+{
+    MT19937RandGen rng(1);
+    zipf_table_distribution<> zipf(state.range(0), 1.1);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(zipf(rng));
+}
+BENCHMARK(BM_zipf_table)->Arg(1000)->Arg(1000000);
+
+// Arguments: population size, tournament size. Selects the whole
+// population size at each iteration.
+void BM_tournament_selection(benchmark::State& state)
+{
+    MT19937RandGen rng(1);
+    std::vector<double> pop(state.range(0));
+    for (double& v : pop)
+        v = rng.randdouble();
+    tournament_selection ts(state.range(1), rng);
+    std::vector<double> winners;
+    winners.reserve(pop.size());
+    for (auto _ : state) {
+        winners.clear();
+        ts(pop.begin(), pop.end(), back_inserter(winners), pop.size());
+        benchmark::DoNotOptimize(winners.data());
+    }
+    state.SetItemsProcessed(state.iterations() * pop.size());
+}
+BENCHMARK(BM_tournament_selection)->Args({1000, 2})->Args({1000, 8});
+
+void BM_roulette_select(benchmark::State& state)
+{
+    MT19937RandGen rng(1);
+    std::vector<double> scores(state.range(0));
+    double sum = 0;
+    for (double& v : scores)
+        sum += v = rng.randdouble();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(roulette_select(scores.begin(),
+                                                 scores.end(), sum, rng));
+}
+BENCHMARK(BM_roulette_select)->Arg(100)->Arg(10000);
+
+// Draw all numbers of [0, n) without replacement
+void BM_lazy_random_selector(benchmark::State& state)
+{
+    MT19937RandGen rng(1);
+    for (auto _ : state) {
+        lazy_random_selector sel(state.range(0), rng);
+        while (not sel.empty())
+            benchmark::DoNotOptimize(sel());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_lazy_random_selector)->Arg(1000)->Arg(100000);
+
+} // namespace
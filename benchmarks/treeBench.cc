@@ -0,0 +1,215 @@
+/*
+ * benchmarks/treeBench.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// tree, CoverTree and digraph operations
+
+#include <cmath>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <opencog/util/Cover_Tree.h>
+#include <opencog/util/digraph.h>
+#include <opencog/util/mt19937ar.h>
+#include <opencog/util/tree.h>
+
+#include "perfReport.h"
+
+using namespace opencog;
+
+namespace {
+
+// Tree of n nodes, each one a child of a random earlier node
+tree<int> random_tree(int n)
+{
+    MT19937RandGen rng(1);
+    tree<int> tr;
+    std::vector<tree<int>::iterator> nodes;
+    nodes.push_back(tr.set_head(0));
+    for (int i = 1; i < n; ++i)
+        nodes.push_back(tr.append_child(nodes[rng.randint(nodes.size())], i));
+    return tr;
+}
+
+void BM_tree_build(benchmark::State& state)
+{
+    for (auto _ : state)
+        benchmark::DoNotOptimize(random_tree(state.range(0)));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_tree_build)->Arg(1000)->Arg(100000);
+
+void BM_tree_pre_order(benchmark::State& state)
+{
+    tree<int> tr = random_tree(state.range(0));
+    perf_report pr(state);
+    for (auto _ : state) {
+        long sum = 0;
+        for (int v : tr)
+            sum += v;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_tree_pre_order)->Arg(1000)->Arg(100000);
+
+void BM_tree_copy(benchmark::State& state)
+{
+    tree<int> tr = random_tree(state.range(0));
+    perf_report pr(state);
+    for (auto _ : state) {
+        tree<int> cp(tr);
+        benchmark::DoNotOptimize(cp.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_tree_copy)->Arg(1000)->Arg(100000);
+
+void BM_tree_equal(benchmark::State& state)
+{
+    tree<int> tr = random_tree(state.range(0)), cp(tr);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(tr == cp);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_tree_equal)->Arg(1000)->Arg(100000);
+
+// Point of the unit cube, with the Euclidean distance
+struct cube_point
+{
+    std::vector<double> x;
+    double distance(const cube_point& p) const
+    {
+        double d = 0;
+        for (size_t i = 0; i < x.size(); ++i)
+            d += (x[i] - p.x[i]) * (x[i] - p.x[i]);
+        return std::sqrt(d);
+    }
+    bool operator==(const cube_point& p) const { return x == p.x; }
+};
+
+std::vector<cube_point> random_points(size_t n, size_t dim)
+{
+    MT19937RandGen rng(1);
+    std::vector<cube_point> pts(n);
+    for (cube_point& p : pts) {
+        p.x.resize(dim);
+        for (double& v : p.x)
+            v = rng.randdouble();
+    }
+    return pts;
+}
+
+// Arguments: number of points, dimension
+void BM_cover_tree_insert(benchmark::State& state)
+{
+    std::vector<cube_point> pts = random_points(state.range(0),
+                                                state.range(1));
+    for (auto _ : state) {
+        CoverTree<cube_point> ct(std::sqrt((double)state.range(1)) + 1);
+        for (const cube_point& p : pts)
+            ct.insert(p);
+    }
+    state.SetItemsProcessed(state.iterations() * pts.size());
+}
+BENCHMARK(BM_cover_tree_insert)->Args({1000, 3})->Args({1000, 20});
+
+void BM_cover_tree_knn(benchmark::State& state)
+{
+    std::vector<cube_point> pts = random_points(state.range(0),
+                                                state.range(1)),
+        queries = random_points(100, state.range(1));
+    CoverTree<cube_point> ct(std::sqrt((double)state.range(1)) + 1, pts);
+    size_t i = 0;
+    perf_report pr(state);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(
+            ct.k_nearest_neighbors(queries[i++ % queries.size()], 10));
+}
+BENCHMARK(BM_cover_tree_knn)->Args({10000, 3})->Args({10000, 20});
+
+// Random dag of n nodes and about 4n edges, from lower to higher
+// node numbers
+std::vector<csr_digraph::edge> random_dag(unsigned n)
+{
+    MT19937RandGen rng(1);
+    std::vector<csr_digraph::edge> edges;
+    for (unsigned dst = 1; dst < n; ++dst)
+        for (int i = 0; i < 4; ++i)
+            edges.emplace_back(rng.randint(dst), dst);
+    return edges;
+}
+
+void BM_digraph_randomized_topological_sort(benchmark::State& state)
+{
+    digraph g(state.range(0));
+    for (const auto& e : random_dag(state.range(0)))
+        g.insert(e.first, e.second);
+    MT19937RandGen rng(1);
+    std::vector<digraph::value_type> order;
+    perf_report pr(state);
+    for (auto _ : state) {
+        order.clear();
+        randomized_topological_sort(g, back_inserter(order), rng);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_digraph_randomized_topological_sort)->Arg(100000);
+
+void BM_csr_randomized_topological_sort(benchmark::State& state)
+{
+    csr_digraph g(state.range(0), random_dag(state.range(0)));
+    MT19937RandGen rng(1);
+    std::vector<csr_digraph::value_type> order;
+    perf_report pr(state);
+    for (auto _ : state) {
+        order.clear();
+        randomized_topological_sort(g, back_inserter(order), rng);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_csr_randomized_topological_sort)->Arg(100000);
+
+void BM_csr_topological_sort(benchmark::State& state)
+{
+    csr_digraph g(state.range(0), random_dag(state.range(0)));
+    std::vector<csr_digraph::value_type> order;
+    for (auto _ : state) {
+        order.clear();
+        topological_sort(g, back_inserter(order));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_csr_topological_sort)->Arg(100000);
+
+void BM_csr_parallel_topological_sort(benchmark::State& state)
+{
+    csr_digraph g(state.range(0), random_dag(state.range(0)));
+    std::vector<csr_digraph::value_type> order;
+    for (auto _ : state) {
+        order.clear();
+        parallel_topological_sort(g, back_inserter(order));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_csr_parallel_topological_sort)->Arg(100000)->UseRealTime();
+
+} // namespace
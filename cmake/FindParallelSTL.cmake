@@ -1,12 +1,48 @@
 INCLUDE ( CheckIncludeFileCXX )
+INCLUDE ( CheckCXXSourceCompiles )
 CHECK_INCLUDE_FILE_CXX ( parallel/algorithm HAVE_PARALLEL_ALGORITHM )
 
-if ( HAVE_PARALLEL_ALGORITHM )
+# The libstdc++ parallel mode runs on OpenMP, which its users must
+# then be compiled and linked with: PARALLEL_STL_LIBRARIES is set to
+# what the users of parallel STL must link with.
+find_package( OpenMP QUIET )
+set( PARALLEL_STL_LIBRARIES )
+if ( HAVE_PARALLEL_ALGORITHM AND OpenMP_CXX_FOUND )
 	set( PARALLEL_STL_FOUND TRUE )
-endif ( HAVE_PARALLEL_ALGORITHM )
+	list( APPEND PARALLEL_STL_LIBRARIES OpenMP::OpenMP_CXX )
+endif ( HAVE_PARALLEL_ALGORITHM AND OpenMP_CXX_FOUND )
 
 if ( PARALLEL_STL_FOUND )
 	message( STATUS "C++ library standardizes parallelism" )
 else ( PARALLEL_STL_FOUND )
 	message( STATUS "Standard C++ parallelism not found" )
 endif ( PARALLEL_STL_FOUND )
+
+# C++17 execution policies. libstdc++ implements them on top of TBB,
+# which must then be linked in as well.
+find_package( TBB CONFIG QUIET )
+set( CMAKE_REQUIRED_QUIET TRUE )
+if ( TBB_FOUND )
+	set( CMAKE_REQUIRED_LIBRARIES TBB::tbb )
+endif ( TBB_FOUND )
+CHECK_CXX_SOURCE_COMPILES( "
+	#include <algorithm>
+	#include <execution>
+	#include <vector>
+	int main() {
+		std::vector<int> v(100);
+		std::sort(std::execution::par, v.begin(), v.end());
+		return 0;
+	}" HAVE_STD_EXECUTION )
+unset( CMAKE_REQUIRED_LIBRARIES )
+unset( CMAKE_REQUIRED_QUIET )
+
+if ( HAVE_STD_EXECUTION )
+	set( PARALLEL_STL_EXECUTION_FOUND TRUE )
+	if ( TBB_FOUND )
+		list( APPEND PARALLEL_STL_LIBRARIES TBB::tbb )
+	endif ( TBB_FOUND )
+	message( STATUS "C++17 execution policies found" )
+else ( HAVE_STD_EXECUTION )
+	message( STATUS "C++17 execution policies not found" )
+endif ( HAVE_STD_EXECUTION )
@@ -25,6 +25,7 @@
 #include "Config.h"
 #include "Logger.h"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -32,7 +33,13 @@
 #include <cstdlib>
 
 #include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
 #include <unistd.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
 
 // For backward compatibility as from boost 1.46 filesystem 3 is the default
 // as of boost 1.50 there is no version 2, and compiles will fail ;-(
@@ -64,6 +71,42 @@ static string strip(string const& str, char const *strip_chars = blank_chars)
 }
 
 
+// Hazard pointers: the snapshot each thread is reading, if any
+namespace {
+struct hazard_registry
+{
+    std::mutex mtx;
+    std::vector<std::atomic<const void*>*> slots;
+};
+
+hazard_registry& hazards()
+{
+    // Leaked, so that it outlives threads exiting after main
+    static hazard_registry* registry = new hazard_registry;
+    return *registry;
+}
+
+struct hazard_slot
+{
+    std::atomic<const void*> ptr;
+
+    hazard_slot() : ptr(nullptr)
+    {
+        hazard_registry& r = hazards();
+        std::lock_guard<std::mutex> lock(r.mtx);
+        r.slots.push_back(&ptr);
+    }
+    ~hazard_slot()
+    {
+        hazard_registry& r = hazards();
+        std::lock_guard<std::mutex> lock(r.mtx);
+        r.slots.erase(std::find(r.slots.begin(), r.slots.end(), &ptr));
+    }
+};
+
+thread_local hazard_slot tls_hazard;
+}
+
 Config* Config::createInstance()
 {
     return new Config();
@@ -73,18 +116,135 @@ Config::~Config()
 {
 }
 
-Config::Config()
+Config::Config() : _n_published(0), _current(nullptr)
 {
     reset();
 }
 
+const ConfigSnapshot* Config::read_begin(std::atomic<const void*>*& hazard) const
+{
+    hazard = &tls_hazard.ptr;
+    const ConfigSnapshot* snap = _current.load(std::memory_order_acquire);
+    while (true) {
+        // The snapshot cannot be freed once announced, provided it is
+        // still current, that is, not retired before being announced
+        hazard->store(snap, std::memory_order_seq_cst);
+        const ConfigSnapshot* current = _current.load(std::memory_order_seq_cst);
+        if (current == snap)
+            return snap;
+        snap = current;
+    }
+}
+
+std::shared_ptr<const ConfigSnapshot> Config::snapshot() const
+{
+    std::atomic<const void*>* hazard;
+    const ConfigSnapshot* snap = read_begin(hazard);
+    std::shared_ptr<const ConfigSnapshot> held = snap->shared_from_this();
+    hazard->store(nullptr, std::memory_order_release);
+    return held;
+}
+
 void Config::reset()
 {
+    std::lock_guard<std::recursive_mutex> lock(_publish_mtx);
     _table.clear();
     _no_config_loaded = true;
     _had_to_search = true;
     _abs_path = "";
     _cfg_filename = "";
+    publish();
+}
+
+// Parse str into a value of the same type as dfl
+static config_value parse_value(const string& name, const string& str,
+                                const config_value& dfl)
+{
+    try {
+        switch (dfl.index()) {
+        case 0:
+            if (boost::iequals(str, "true")) return true;
+            if (boost::iequals(str, "false")) return false;
+            throw boost::bad_lexical_cast();
+        case 1: return boost::lexical_cast<int>(str);
+        case 2: return boost::lexical_cast<long>(str);
+        case 3: return boost::lexical_cast<double>(str);
+        default: return str;
+        }
+    } catch (boost::bad_lexical_cast&) {
+        static const char* type_names[] = {"bool", "integer", "long integer",
+                                           "double", "string"};
+        throw InvalidParamException(TRACE_INFO,
+               "[ERROR] invalid %s parameter (%s: %s)",
+               type_names[dfl.index()], name.c_str(), str.c_str());
+    }
+}
+
+size_t Config::register_param(const string& name, const config_value& dfl)
+{
+    std::lock_guard<std::recursive_mutex> lock(_publish_mtx);
+    for (size_t i = 0; i < _params.size(); ++i) {
+        if (_params[i].name == name) {
+            if (_params[i].dfl.index() != dfl.index())
+                throw InvalidParamException(TRACE_INFO,
+                       "[ERROR] parameter %s registered with another type",
+                       name.c_str());
+            return i;
+        }
+    }
+    _params.push_back({name, dfl});
+    try {
+        publish();
+    } catch (...) {
+        _params.pop_back();
+        throw;
+    }
+    return _params.size() - 1;
+}
+
+void Config::publish()
+{
+    std::lock_guard<std::recursive_mutex> lock(_publish_mtx);
+    std::shared_ptr<ConfigSnapshot> snap(new ConfigSnapshot);
+    snap->_table = _table;
+    snap->_values.reserve(_params.size());
+    for (const param_info& p : _params) {
+        auto it = _table.find(p.name);
+        snap->_values.push_back(it == _table.end() ? p.dfl
+                                : parse_value(p.name, it->second, p.dfl));
+    }
+    snap->_strings.resize(_params.size(), nullptr);
+    for (size_t i = 0; i < _params.size(); ++i) {
+        if (const std::string* str = std::get_if<std::string>(&snap->_values[i]))
+            snap->_strings[i] = &*_interned.insert(*str).first;
+    }
+    snap->_version = _n_published++;
+
+    _current.store(snap.get(), std::memory_order_seq_cst);
+    if (_snapshot)
+        _retired.push_back(std::move(_snapshot));
+    _snapshot = snap;
+    reclaim();
+}
+
+void Config::reclaim()
+{
+    std::vector<const void*> announced;
+    {
+        hazard_registry& r = hazards();
+        std::lock_guard<std::mutex> lock(r.mtx);
+        announced.reserve(r.slots.size());
+        for (const std::atomic<const void*>* hazard : r.slots)
+            announced.push_back(hazard->load(std::memory_order_seq_cst));
+    }
+    // Snapshots still held by snapshot() callers are freed when
+    // released
+    auto freed = [&](const std::shared_ptr<const ConfigSnapshot>& s) {
+        return std::find(announced.begin(), announced.end(), s.get())
+            == announced.end();
+    };
+    _retired.erase(std::remove_if(_retired.begin(), _retired.end(), freed),
+                   _retired.end());
 }
 
 static const char* DEFAULT_CONFIG_FILENAME = "opencog.conf";
@@ -109,8 +269,21 @@ static const char* DEFAULT_CONFIG_PATHS[] =
     NULL
 };
 
+std::string Config::path_where_found() const
+{
+    std::lock_guard<std::recursive_mutex> lock(_publish_mtx);
+    return _path_where_found;
+}
+
+std::string Config::search_file() const
+{
+    std::lock_guard<std::recursive_mutex> lock(_publish_mtx);
+    return _cfg_filename;
+}
+
 const std::vector<std::string> Config::search_paths() const
 {
+    std::lock_guard<std::recursive_mutex> lock(_publish_mtx);
     std::vector<std::string> paths;
     if (_had_to_search)
     {
@@ -162,10 +335,14 @@ void Config::load(const char* filename, bool resetFirst)
     if (NULL == filename or 0 == filename[0])
         filename = DEFAULT_CONFIG_FILENAME;
 
+    // The file names are read by reload(), from a ConfigWatcher thread
+    std::lock_guard<std::recursive_mutex> lock(_publish_mtx);
+
     // Reset to default values
     if (resetFirst) reset();
 
     _cfg_filename = filename;
+    _path_where_found = "";
 
     ifstream fin;
 
@@ -205,8 +382,35 @@ void Config::load(const char* filename, bool resetFirst)
              "unable to open file \"%s\"", filename);
     }
 
+    // Parse into a copy, swapped in only if all the registered
+    // parameters are valid
+    std::map<std::string, std::string> table(_table);
+    parse(fin, table);
+    fin.close();
+
+    _table.swap(table);
+    try {
+        publish();
+    } catch (...) {
+        _table.swap(table);
+        throw;
+    }
     _no_config_loaded = false;
 
+    // Finish configuring the logger... The config file itself
+    // contains the location of the log file. This is working around
+    // a chicken-and-egg problem with reporting config file issues.
+    // Such is life; this is a lot easier than debugging screwed-up
+    // file-path craziness in a debugger. We MUST log the path!!!
+    setup_logger();
+
+    // And then finally, at long last!!! report what happened.
+    logger().info("Using config file found at: %s\n",
+                  path_where_found().c_str());
+}
+
+void Config::parse(std::istream& fin, std::map<std::string, std::string>& table)
+{
     string line;
     string name;
     string value;
@@ -275,24 +479,32 @@ void Config::load(const char* filename, bool resetFirst)
         if (have_name && have_value)
         {
             // Finally, store the entries.
-            _table[name] = value;
+            table[name] = value;
             have_name = false;
             have_value = false;
             value = "";
         }
     }
-    fin.close();
+}
 
-    // Finish configuring the logger... The config file itself
-    // contains the location of the log file. This is working around
-    // a chicken-and-egg problem with reporting config file issues.
-    // Such is life; this is a lot easier than debugging screwed-up
-    // file-path craziness in a debugger. We MUST log the path!!!
+void Config::reload()
+{
+    std::lock_guard<std::recursive_mutex> lock(_publish_mtx);
+    ifstream fin(_path_where_found.c_str());
+    if (not fin.is_open())
+        throw IOException(TRACE_INFO, "unable to open file \"%s\"",
+                          _path_where_found.c_str());
+    std::map<std::string, std::string> table;
+    parse(fin, table);
+
+    _table.swap(table);
+    try {
+        publish();
+    } catch (...) {
+        _table.swap(table);
+        throw;
+    }
     setup_logger();
-
-    // And then finally, at long last!!! report what happened.
-    logger().info("Using config file found at: %s\n",
-                  path_where_found().c_str());
 }
 
 void Config::setup_logger()
@@ -310,40 +522,67 @@ void Config::setup_logger()
 }
 
 const bool Config::has(const string &name) const
+{
+    string value;
+    return lookup(name, value);
+}
+
+bool Config::lookup(const string& name, string& value) const
 {
     if (_no_config_loaded)
         logger().warn("No configuration file was loaded! Param=%s",
                       name.c_str());
-    return (_table.find(name) != _table.end());
+    std::shared_ptr<const ConfigSnapshot> snap = snapshot();
+    auto it = snap->table().find(name);
+    if (it == snap->table().end())
+        return false;
+    value = it->second;
+    return true;
 }
 
 void Config::set(const std::string &parameter_name,
                  const std::string &parameter_value)
 {
-    _no_config_loaded = false;
+    std::lock_guard<std::recursive_mutex> lock(_publish_mtx);
+    auto it = _table.find(parameter_name);
+    bool existed = it != _table.end();
+    std::string old_value = existed ? it->second : "";
     _table[parameter_name] = parameter_value;
+    try {
+        publish();
+    } catch (...) {
+        // Restore the previous value, the snapshot is unchanged
+        if (existed)
+            _table[parameter_name] = old_value;
+        else
+            _table.erase(parameter_name);
+        throw;
+    }
+    _no_config_loaded = false;
 }
 
-const string& Config::get(const string& name, const string& dfl) const
+string Config::get(const string& name, const string& dfl) const
 {
-    if (not has(name)) return dfl;
-    return _table.find(name)->second;
+    string value;
+    return lookup(name, value) ? value : dfl;
 }
 
-const string& Config::operator[](const string &name) const
+string Config::operator[](const string &name) const
 {
-    if (not has(name))
+    string value;
+    if (not lookup(name, value))
        throw InvalidParamException(TRACE_INFO,
                                    "[ERROR] parameter not found (%s)",
                                    name.c_str());
-    return _table.find(name)->second;
+    return value;
 }
 
 int Config::get_int(const string &name, int dfl) const
 {
-    if (not has(name)) return dfl;
+    string value;
+    if (not lookup(name, value)) return dfl;
     try {
-        return boost::lexical_cast<int>(get(name));
+        return boost::lexical_cast<int>(value);
     } catch (boost::bad_lexical_cast&) {
         throw InvalidParamException(TRACE_INFO,
                "[ERROR] invalid integer parameter (%s)",
@@ -353,9 +592,10 @@ int Config::get_int(const string &name, int dfl) const
 
 long Config::get_long(const string &name, long dfl) const
 {
-    if (not has(name)) return dfl;
+    string value;
+    if (not lookup(name, value)) return dfl;
     try {
-        return boost::lexical_cast<long>(get(name));
+        return boost::lexical_cast<long>(value);
     } catch (boost::bad_lexical_cast&) {
         throw InvalidParamException(TRACE_INFO,
                "[ERROR] invalid long integer parameter (%s)",
@@ -365,9 +605,10 @@ long Config::get_long(const string &name, long dfl) const
 
 double Config::get_double(const string &name, double dfl) const
 {
-    if (not has(name)) return dfl;
+    string value;
+    if (not lookup(name, value)) return dfl;
     try {
-        return boost::lexical_cast<double>(get(name));
+        return boost::lexical_cast<double>(value);
     } catch (boost::bad_lexical_cast&) {
         throw InvalidParamException(TRACE_INFO,
                "[ERROR] invalid double parameter (%s)",
@@ -377,26 +618,208 @@ double Config::get_double(const string &name, double dfl) const
 
 bool Config::get_bool(const string &name, bool dfl) const
 {
-    if (not has(name)) return dfl;
-    if (boost::iequals(get(name), "true")) return true;
-    else if (boost::iequals(get(name), "false")) return false;
+    string value;
+    if (not lookup(name, value)) return dfl;
+    if (boost::iequals(value, "true")) return true;
+    else if (boost::iequals(value, "false")) return false;
     else throw InvalidParamException(TRACE_INFO,
                 "[ERROR] invalid bool parameter (%s: %s)",
-                name.c_str(), get(name).c_str());
+                name.c_str(), value.c_str());
 }
 
 std::string Config::to_string() const
 {
+    std::shared_ptr<const ConfigSnapshot> snap = snapshot();
+    const std::map<std::string, std::string>& table = snap->table();
     std::ostringstream oss;
     oss << "{\"";
-    for (auto it = _table.begin(); it != _table.end(); ++it) {
-        if (it != _table.begin()) oss << "\", \"";
+    for (auto it = table.begin(); it != table.end(); ++it) {
+        if (it != table.begin()) oss << "\", \"";
         oss << it->first << "\" => \"" << it->second;
     }
     oss << "\"}";
     return oss.str();
 }
 
+ConfigWatcher::ConfigWatcher(Config& c, std::chrono::milliseconds poll_interval)
+    : _config(c), _path(c.path_where_found()), _poll_interval(poll_interval),
+      _n_reloads(0), _stop(false), _wake_fd{-1, -1}, _inotify_fd(-1)
+{
+    if (_path.empty())
+        throw IOException(TRACE_INFO,
+              "ConfigWatcher - no config file was loaded");
+    if (pipe(_wake_fd) < 0)
+        throw IOException(TRACE_INFO,
+              "ConfigWatcher - cannot create pipe: %s", strerror(errno));
+    _last_mtime = file_mtime();
+#ifdef __linux__
+    // Watch the directory, editors often replace the file by another
+    std::string::size_type slash = _path.rfind('/');
+    std::string dir = slash == std::string::npos ?
+        "." : _path.substr(0, slash + 1);
+    _inotify_fd = inotify_init1(IN_CLOEXEC);
+    if (_inotify_fd >= 0 and
+        inotify_add_watch(_inotify_fd, dir.c_str(),
+                          IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+    {
+        close(_inotify_fd);
+        _inotify_fd = -1;
+    }
+#endif
+    _thread = std::thread(&ConfigWatcher::watch_loop, this);
+}
+
+ConfigWatcher::~ConfigWatcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(_stop_mtx);
+        _stop = true;
+    }
+    _stop_cv.notify_all();
+    char c = 0;
+    if (write(_wake_fd[1], &c, 1) < 0)
+        logger().warn("ConfigWatcher - cannot wake up the watcher thread");
+    _thread.join();
+    close(_wake_fd[0]);
+    close(_wake_fd[1]);
+}
+
+int ConfigWatcher::connect(const std::string& key, const slot_type& slot)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    std::unique_ptr<key_signal>& sig = _key_signals[key];
+    if (not sig)
+        sig.reset(new key_signal);
+    return sig->connect(slot);
+}
+
+void ConfigWatcher::disconnect(const std::string& key, int id)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    auto it = _key_signals.find(key);
+    if (it != _key_signals.end())
+        it->second->disconnect(id);
+}
+
+int ConfigWatcher::connect_all(const slot_type& slot)
+{
+    return _all_signal.connect(slot);
+}
+
+void ConfigWatcher::disconnect_all(int id)
+{
+    _all_signal.disconnect(id);
+}
+
+bool ConfigWatcher::reload()
+{
+    std::lock_guard<std::mutex> reload_lock(_reload_mtx);
+    std::shared_ptr<const ConfigSnapshot> before = _config.snapshot();
+    try {
+        _config.reload();
+    } catch (const StandardException& e) {
+        logger().warn("ConfigWatcher - cannot reload %s: %s",
+                      _path.c_str(), e.get_message());
+        return false;
+    }
+    std::shared_ptr<const ConfigSnapshot> after = _config.snapshot();
+    ++_n_reloads;
+
+    // Both tables are sorted, walk them together
+    static const std::string none;
+    std::vector<std::pair<std::string, std::pair<const std::string*,
+                                                 const std::string*>>> changes;
+    auto l = before->table().begin(), r = after->table().begin();
+    while (l != before->table().end() or r != after->table().end()) {
+        if (r == after->table().end()
+            or (l != before->table().end() and l->first < r->first)) {
+            changes.push_back({l->first, {&l->second, &none}});
+            ++l;
+        } else if (l == before->table().end() or r->first < l->first) {
+            changes.push_back({r->first, {&none, &r->second}});
+            ++r;
+        } else {
+            if (l->second != r->second)
+                changes.push_back({l->first, {&l->second, &r->second}});
+            ++l;
+            ++r;
+        }
+    }
+
+    for (const auto& ch : changes) {
+        key_signal* sig = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            auto it = _key_signals.find(ch.first);
+            if (it != _key_signals.end())
+                sig = it->second.get();
+        }
+        if (sig)
+            sig->emit(ch.first, *ch.second.first, *ch.second.second);
+        _all_signal.emit(ch.first, *ch.second.first, *ch.second.second);
+    }
+    return true;
+}
+
+long long ConfigWatcher::file_mtime() const
+{
+    struct stat st;
+    if (stat(_path.c_str(), &st) < 0)
+        return -1;
+    return st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec;
+}
+
+void ConfigWatcher::watch_loop()
+{
+#ifdef __linux__
+    if (_inotify_fd >= 0) {
+        std::string::size_type slash = _path.rfind('/');
+        std::string base = _path.substr(slash == std::string::npos ? 0 : slash + 1);
+        char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+        struct pollfd fds[2] = {{_inotify_fd, POLLIN, 0}, {_wake_fd[0], POLLIN, 0}};
+        while (not _stop) {
+            if (poll(fds, 2, -1) < 0) {
+                if (errno == EINTR) continue;
+                break;
+            }
+            if (_stop or fds[1].revents)
+                break;
+            ssize_t len = read(_inotify_fd, buf, sizeof(buf));
+            bool changed = false;
+            for (char* p = buf; p < buf + len; ) {
+                struct inotify_event* ev = (struct inotify_event*)p;
+                if (ev->len > 0 and base == ev->name)
+                    changed = true;
+                p += sizeof(struct inotify_event) + ev->len;
+            }
+            if (changed)
+                reload();
+        }
+        close(_inotify_fd);
+        return;
+    }
+#endif
+    poll_loop();
+}
+
+void ConfigWatcher::poll_loop()
+{
+    long long last = _last_mtime;
+    std::unique_lock<std::mutex> lock(_stop_mtx);
+    while (not _stop) {
+        _stop_cv.wait_for(lock, _poll_interval);
+        if (_stop)
+            break;
+        long long mtime = file_mtime();
+        if (mtime != last and mtime >= 0) {
+            last = mtime;
+            lock.unlock();
+            reload();
+            lock.lock();
+        }
+    }
+}
+
 // create and return the single instance
 Config& opencog::config(ConfigFactory* factoryFunction,
                         bool overwrite)
@@ -25,23 +25,144 @@
 #ifndef _OPENCOG_CONFIG_H
 #define _OPENCOG_CONFIG_H
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <fstream>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <thread>
+#include <variant>
 #include <vector>
 
+#include <opencog/util/sigslot.h>
+
 namespace opencog
 {
 /** \addtogroup grp_cogutil
  *  @{
  */
 
+class Config;
+
+//! Parsed value of a typed configuration parameter
+typedef std::variant<bool, int, long, double, std::string> config_value;
+
+template<typename T> class config_param;
+
+//! Type of the values of parameters of type T: a copy, but for
+//! strings, which are interned by Config and returned by reference
+template<typename T>
+struct config_result { typedef T type; };
+template<>
+struct config_result<std::string> { typedef const std::string& type; };
+
+/**
+ * Immutable state of the configuration at some point in time: the
+ * raw key/value table and the parsed value of every registered
+ * parameter. Reading several parameters from the same snapshot gives
+ * a consistent view even if the configuration changes meanwhile.
+ */
+class ConfigSnapshot : public std::enable_shared_from_this<ConfigSnapshot>
+{
+public:
+    //! Value of a parameter registered with Config::param
+    template<typename T>
+    typename config_result<T>::type get(const config_param<T>& p) const
+    {
+        return value<T>(p.index());
+    }
+
+    //! Raw key/value table
+    const std::map<std::string, std::string>& table() const { return _table; }
+
+    //! Number of changes published before this snapshot
+    unsigned long version() const { return _version; }
+
+private:
+    friend class Config;
+
+    template<typename T>
+    typename config_result<T>::type value(size_t i) const
+    {
+        return std::get<T>(_values[i]);
+    }
+
+    std::map<std::string, std::string> _table;
+    std::vector<config_value> _values;
+    // Interned value of each string parameter, nullptr for the others
+    std::vector<const std::string*> _strings;
+    unsigned long _version;
+};
+
+template<>
+inline const std::string& ConfigSnapshot::value<std::string>(size_t i) const
+{
+    return *_strings[i];
+}
+
+/**
+ * Handle on a typed configuration parameter, returned by
+ * Config::param. Reading it loads the current snapshot, without
+ * locking nor reference counting, and accesses an array: no lookup,
+ * no parsing. Values are copied, but for strings, returned by a
+ * reference that stays valid as long as the Config. To read several
+ * parameters consistently, hold a Config::snapshot().
+ */
+template<typename T>
+class config_param
+{
+public:
+    typedef typename config_result<T>::type result_type;
+
+    //! Current value of the parameter
+    result_type get() const;
+    result_type operator()() const { return get(); }
+
+    const std::string& name() const { return _name; }
+    size_t index() const { return _index; }
+
+private:
+    friend class Config;
+    config_param(const Config* c, const std::string& name, size_t index)
+        : _config(c), _name(name), _index(index) {}
+
+    const Config* _config;
+    std::string _name;
+    size_t _index;
+};
+
 //! library-wide configuration; keys and values are strings
+/**
+ * String lookups (get, get_int, ...) search the current snapshot and
+ * parse the value on each call; they return copies, so they are safe
+ * while the configuration changes, for instance when reloaded by a
+ * ConfigWatcher. Besides, parameters can be registered with a type
+ * and a default value by param(). Their values are then parsed once,
+ * whenever the configuration changes (load, set, reset), and
+ * published with the raw table as a new immutable ConfigSnapshot.
+ * The values of string parameters are interned: each distinct value
+ * is kept, at a fixed address, until the Config is destroyed.
+ *
+ * Readers load the pointer to the current snapshot and announce it
+ * in a hazard pointer of their thread while they read it, so they
+ * never wait for writers (but for the first read of a thread, which
+ * registers it) and see changes atomically (read-copy-update). A
+ * snapshot replaced by a newer one is freed once no reader announces
+ * it, and no holder of snapshot() keeps it, so that frequent changes
+ * or reloads do not accumulate copies of the table.
+ */
 class Config
 {
 protected:
+    // Table the next snapshot is made of, only used by writers under
+    // _publish_mtx; readers use the current snapshot
     std::map<std::string, std::string> _table;
-    bool _no_config_loaded;
+    std::atomic<bool> _no_config_loaded;
+    // Protected by _publish_mtx, like the table
     bool _had_to_search;
     std::string _path_where_found;
     std::string _abs_path;
@@ -49,6 +170,11 @@ protected:
 
     void check_for_file(std::ifstream&, const char *, const char *);
     void setup_logger();
+    //! Parse the entries of a config file into table
+    void parse(std::istream&, std::map<std::string, std::string>& table);
+    //! Set value to the current value of a parameter and return true,
+    //! or return false if it is not set
+    bool lookup(const std::string& name, std::string& value) const;
 
 public:
     //! constructor
@@ -65,14 +191,22 @@ public:
     //! Parse the indicated file for parameter values.
     void load(const char* config_file, bool resetFirst = true);
 
+    /**
+     * Parse again the file that was loaded, replacing all parameter
+     * values by those of the file, and publish them in a single
+     * snapshot. Throws, leaving the configuration unchanged, if the
+     * file cannot be read or holds invalid values.
+     */
+    void reload();
+
     //! Location at which the config file was found.
-    const std::string& path_where_found() const { return _path_where_found; }
+    std::string path_where_found() const;
 
     //! List of paths that were searched, in looking for the config file.
     const std::vector<std::string> search_paths() const;
 
     //! Name of the file that was actually searched for.
-    const std::string& search_file() const { return _cfg_filename; }
+    std::string search_file() const;
 
     //! Return true if a parameter exists.
     const bool has(const std::string &parameter_name) const;
@@ -81,9 +215,9 @@ public:
     void set(const std::string &parameter_name, const std::string &parameter_value);
 
     //! Return current value of a given parameter.
-    const std::string& get(const std::string &, const std::string& = "") const;
+    std::string get(const std::string &, const std::string& = "") const;
     //! Return current value of a given parameter.
-    const std::string& operator[](const std::string &) const;
+    std::string operator[](const std::string &) const;
 
     //! Return current value of a given parameter as an integer.
     int get_int(const std::string &, int = 0) const;
@@ -99,8 +233,71 @@ public:
 
     //! Dump all configuration parameters to a string.
     std::string to_string() const;
+
+    /**
+     * Register a parameter of type T (bool, int, long, double or
+     * std::string), with a default value used when the parameter is
+     * not set, and return a handle on it. Registering the same name
+     * again returns an equivalent handle, the type must then be the
+     * same. Throws InvalidParamException if the current value cannot
+     * be parsed as a T; later invalid values are rejected by set()
+     * and load() the same way.
+     */
+    template<typename T>
+    config_param<T> param(const std::string& name, const T& dfl)
+    {
+        return config_param<T>(this, name,
+            register_param(name, config_value(std::in_place_type<T>, dfl)));
+    }
+
+    //! Return the current snapshot, which stays valid while held
+    std::shared_ptr<const ConfigSnapshot> snapshot() const;
+
+protected:
+    template<typename T> friend class config_param;
+
+    //! Current snapshot, announced in the hazard pointer of the
+    //! calling thread, returned in hazard, until it is cleared
+    const ConfigSnapshot* read_begin(std::atomic<const void*>*& hazard) const;
+    struct param_info
+    {
+        std::string name;
+        config_value dfl;
+    };
+
+    size_t register_param(const std::string& name, const config_value& dfl);
+
+    //! Parse the registered parameters and publish a new snapshot.
+    //! Throws InvalidParamException, leaving the current snapshot, if
+    //! a value cannot be parsed.
+    void publish();
+
+    //! Free the replaced snapshots no reader announces, _publish_mtx
+    //! held
+    void reclaim();
+
+    // Serializes the writers of snapshots
+    mutable std::recursive_mutex _publish_mtx;
+    std::vector<param_info> _params;
+    unsigned long _n_published;
+    std::set<std::string> _interned;
+    // Current snapshot, for readers, and its owner, for writers
+    std::atomic<const ConfigSnapshot*> _current;
+    std::shared_ptr<const ConfigSnapshot> _snapshot;
+    // Replaced snapshots, until no reader announces them
+    std::vector<std::shared_ptr<const ConfigSnapshot>> _retired;
 };
 
+template<typename T>
+typename config_param<T>::result_type config_param<T>::get() const
+{
+    std::atomic<const void*>* hazard;
+    const ConfigSnapshot* snap = _config->read_begin(hazard);
+    result_type value = snap->get(*this);
+    hazard->store(nullptr, std::memory_order_release);
+    return value;
+}
+
 //! singleton instance (following meyer's design pattern)
 /**
  * Nil: if overwrite is true then the static variable instance@n
@@ -111,6 +308,95 @@ typedef Config* ConfigFactory(void);
 Config& config(ConfigFactory* = Config::createInstance,
                bool overwrite = false);
 
+/**
+ * Reload a Config whenever its file changes, and notify subscribers
+ * of the parameters whose values changed.
+ *
+ * The watcher is opt-in: it runs a background thread from its
+ * construction to its destruction. On Linux the thread waits for
+ * inotify events on the directory of the file (so that files replaced
+ * by editors are caught), elsewhere it polls the modification time
+ * every poll_interval. On change, the file is reloaded with
+ * Config::reload, the new snapshot is compared to the previous one,
+ * and the signal of each changed key is emitted, on the watcher
+ * thread, with the key, the old and the new value (an empty string
+ * if the key was added or removed). If the file is invalid, a
+ * warning is logged and the configuration is left as is.
+ *
+ * For instance, to resize a cache when CACHE_SIZE changes:
+ *
+ * ConfigWatcher watcher;
+ * auto size = config().param("CACHE_SIZE", 1000);
+ * watcher.connect("CACHE_SIZE", [&](const std::string&,
+ *                                   const std::string&,
+ *                                   const std::string&) {
+ *     cache.resize(size());
+ * });
+ */
+class ConfigWatcher
+{
+public:
+    typedef SigSlot<const std::string&, const std::string&,
+                    const std::string&> key_signal;
+    typedef key_signal::slot_type slot_type;
+
+    //! Watch the file c was loaded from. Throws an IOException if no
+    //! file was loaded.
+    ConfigWatcher(Config& c = config(),
+                  std::chrono::milliseconds poll_interval
+                  = std::chrono::milliseconds(1000));
+    ~ConfigWatcher();
+
+    ConfigWatcher(const ConfigWatcher&) = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+    //! Call slot whenever the value of key changes. Return an id to
+    //! disconnect it.
+    int connect(const std::string& key, const slot_type& slot);
+    void disconnect(const std::string& key, int id);
+
+    //! Call slot whenever any value changes
+    int connect_all(const slot_type& slot);
+    void disconnect_all(int id);
+
+    /**
+     * Reload the file now, in the calling thread, and notify the
+     * subscribers. Return false if the file could not be reloaded.
+     */
+    bool reload();
+
+    //! Number of successful reloads so far
+    unsigned long n_reloads() const { return _n_reloads; }
+
+private:
+    void watch_loop();
+    void poll_loop();
+    //! Modification time of the file, in nanoseconds, or -1
+    long long file_mtime() const;
+
+    Config& _config;
+    std::string _path;
+    std::chrono::milliseconds _poll_interval;
+
+    // Serializes reloads
+    std::mutex _reload_mtx;
+    // Protects _key_signals; signals are never removed from it
+    std::mutex _mtx;
+    std::map<std::string, std::unique_ptr<key_signal>> _key_signals;
+    key_signal _all_signal;
+    std::atomic<unsigned long> _n_reloads;
+
+    // Stop request, and a pipe to wake up the inotify loop
+    std::atomic<bool> _stop;
+    std::mutex _stop_mtx;
+    std::condition_variable _stop_cv;
+    int _wake_fd[2];
+    // Set up before the thread starts, so that no change is missed
+    int _inotify_fd;
+    long long _last_mtime;
+    std::thread _thread;
+};
+
 /** @}*/
 } // namespace opencog
 
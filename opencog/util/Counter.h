@@ -114,8 +114,10 @@ public:
 		T key = super::begin()->first;
 		CT cnt = super::begin()->second;
 		for (const auto& v : *this) {
-			if (cnt < v.second)
+			if (cnt < v.second) {
 				key = v.first;
+				cnt = v.second;
+			}
 		}
 		return key;
 	}
@@ -251,6 +253,210 @@ public:
 	}
 };
 
+//! Counter maintaining its total and mode incrementally
+/**
+ * Counter::total_count() and Counter::mode() walk the whole
+ * container. This variant keeps both aggregates up to date as the
+ * counts are modified, so that reading them is O(1). The mode only
+ * needs to be recomputed, lazily, when the count of the current mode
+ * decreases.
+ *
+ * To keep the aggregates consistent, the counts must be modified via
+ * add(), set(), erase() or the arithmetic operators; operator[] and
+ * the mutable iterators of std::map are therefore not available.
+ * A TrackedCounter can be passed wherever a const Counter is
+ * expected.
+ */
+template<typename T, typename CT, typename CMP = std::less<T>>
+class TrackedCounter : public Counter<T, CT, CMP>
+{
+public:
+	typedef Counter<T, CT, CMP> counter_t;
+	typedef typename counter_t::super super;
+	typedef typename super::value_type value_type;
+	typedef typename super::size_type size_type;
+	typedef typename super::const_iterator const_iterator;
+
+	TrackedCounter() : _total(0), _mode_valid(false) {}
+
+	template<typename IT>
+	TrackedCounter(IT from, IT to) : counter_t(from, to)
+	{
+		reset_aggregates();
+	}
+
+	TrackedCounter(const counter_t& c) : counter_t(c)
+	{
+		reset_aggregates();
+	}
+
+	TrackedCounter(const std::initializer_list<value_type>& il)
+		: counter_t(il)
+	{
+		reset_aggregates();
+	}
+
+	//! Add c to the count of key
+	void add(const T& key, CT c = CT(1))
+	{
+		auto it = super::emplace(key, CT()).first;
+		it->second += c;
+		_total += c;
+		update_mode(it, c < CT());
+	}
+
+	//! Set the count of key to c
+	void set(const T& key, CT c)
+	{
+		auto it = super::emplace(key, CT()).first;
+		bool decreased = c < it->second;
+		_total += c - it->second;
+		it->second = c;
+		update_mode(it, decreased);
+	}
+
+	//! Remove key, return the number of removed elements (0 or 1)
+	size_type erase(const T& key)
+	{
+		auto it = super::find(key);
+		if (it == super::end())
+			return 0;
+		_total -= it->second;
+		if (_mode_valid and not super::key_comp()(key, _mode)
+		    and not super::key_comp()(_mode, key))
+			_mode_valid = false;
+		super::erase(it);
+		return 1;
+	}
+
+	void clear()
+	{
+		super::clear();
+		_total = CT(0);
+		_mode_valid = false;
+	}
+
+	//! Return the total of all counted elements, in O(1)
+	CT total_count() const
+	{
+		return _total;
+	}
+
+	//! Return the mode, the element that occurs most frequently. Ties
+	//! are resolved like Counter::mode, by picking the smallest key.
+	T mode() const
+	{
+		if (not _mode_valid)
+			recompute_mode();
+		return _mode;
+	}
+
+	//! Return the count of the mode
+	CT mode_count() const
+	{
+		if (not _mode_valid)
+			recompute_mode();
+		return _mode_count;
+	}
+
+	// Read-only access to the underlying map
+	const_iterator begin() const { return super::begin(); }
+	const_iterator end() const { return super::end(); }
+	const_iterator find(const T& key) const { return super::find(key); }
+
+	TrackedCounter& operator+=(const counter_t& other) {
+		for (const auto& v : other)
+			add(v.first, v.second);
+		return *this;
+	}
+
+	TrackedCounter& operator-=(const counter_t& other) {
+		for (const auto& v : other)
+			add(v.first, -v.second);
+		return *this;
+	}
+
+	// The remaining operators touch every count anyway, so the
+	// aggregates are simply recomputed.
+	template<typename Arg>
+	TrackedCounter& operator*=(const Arg& arg) {
+		counter_t::operator*=(arg);
+		reset_aggregates();
+		return *this;
+	}
+
+	template<typename Arg>
+	TrackedCounter& operator/=(const Arg& arg) {
+		counter_t::operator/=(arg);
+		reset_aggregates();
+		return *this;
+	}
+
+	TrackedCounter& operator+=(const CT& num) {
+		counter_t::operator+=(num);
+		reset_aggregates();
+		return *this;
+	}
+
+	TrackedCounter& operator-=(const CT& num) {
+		counter_t::operator-=(num);
+		reset_aggregates();
+		return *this;
+	}
+
+	// Untracked mutators
+	CT& operator[](const T&) = delete;
+	template<typename... Args> void insert(Args&&...) = delete;
+	template<typename... Args> void emplace(Args&&...) = delete;
+	template<typename... Args> void emplace_hint(Args&&...) = delete;
+
+private:
+	void reset_aggregates()
+	{
+		_total = counter_t::total_count();
+		_mode_valid = false;
+	}
+
+	void recompute_mode() const
+	{
+		_mode = counter_t::mode();
+		_mode_count = super::find(_mode)->second;
+		_mode_valid = true;
+	}
+
+	void update_mode(typename super::const_iterator it, bool decreased)
+	{
+		if (not _mode_valid) {
+			// First element, nothing to compare with
+			if (super::size() == 1 and not decreased) {
+				_mode = it->first;
+				_mode_count = it->second;
+				_mode_valid = true;
+			}
+			return;
+		}
+		const CMP& cmp = super::key_comp();
+		bool is_mode = not cmp(it->first, _mode) and not cmp(_mode, it->first);
+		if (is_mode) {
+			// The mode may have been overtaken
+			if (decreased)
+				_mode_valid = false;
+			else
+				_mode_count = it->second;
+		} else if (_mode_count < it->second
+		           or (not (it->second < _mode_count)
+		               and cmp(it->first, _mode))) {
+			_mode = it->first;
+			_mode_count = it->second;
+		}
+	}
+
+	CT _total;
+	mutable T _mode;
+	mutable CT _mode_count;
+	mutable bool _mode_valid;
+};
+
 template<typename T, typename CT, typename CMP = std::less<T>>
 std::ostream& operator<<(std::ostream& out, const Counter<T, CT, CMP>& c)
 {
@@ -26,10 +26,15 @@
 
 #include <boost/range/adaptor/map.hpp>
 #include <boost/range/numeric.hpp>
+#include <iterator>
+#include <type_traits>
+#include <vector>
 
 #include <opencog/util/dorepeat.h>
 #include <opencog/util/Logger.h>
 #include <opencog/util/Counter.h>
+#include <opencog/util/oc_assert.h>
+#include <opencog/util/oc_omp.h>
 
 
 namespace opencog {
@@ -66,7 +71,7 @@ struct KLDS {
     //! occurrences of each observations of P
     void set_p_pdf(const pdf_t& p_counter, FloatT p_s_ = -1) {
         p_pdf = p_counter;
-        p_s = p_s_ < 0 ? boost::accumulate(p_pdf | map_values, 0) : p_s_;
+        p_s = p_s_ < 0 ? boost::accumulate(p_pdf | map_values, FloatT(0)) : p_s_;
         x_very_first = p_pdf.cbegin()->first - margin;
         x_very_last = p_pdf.crbegin()->first + margin;
         precompute_delta_p();
@@ -154,8 +159,14 @@ struct KLDS {
 
     //! @return estimate of KL(P||Q)
     FloatT operator()(const pdf_t& q_counter) {
-        FloatT q_s = boost::accumulate(q_counter | map_values, 0),
-            q_x_pre = x_very_first,
+        return operator()(q_counter,
+                          boost::accumulate(q_counter | map_values, FloatT(0)));
+    }
+
+    //! like above but the total count q_s of q_counter is provided
+    //! (by TrackedCounter::total_count() for instance)
+    FloatT operator()(const pdf_t& q_counter, FloatT q_s) {
+        FloatT q_x_pre = x_very_first,
             res = 0;
         pdf_cit cit_p = p_pdf.begin();
         pdf_cit cit_q = q_counter.begin();
@@ -166,9 +177,10 @@ struct KLDS {
 
     //! Fill the output iterator with the KLD component corresponding
     //! to each data point
-    template<typename Out>
+    template<typename Out,
+             typename = typename std::enable_if<!std::is_arithmetic<Out>::value>::type>
     void operator()(const pdf_t& q_counter, Out out) {
-        FloatT q_s = boost::accumulate(q_counter | map_values, 0),
+        FloatT q_s = boost::accumulate(q_counter | map_values, FloatT(0)),
             q_x_pre = x_very_first;
         pdf_cit cit_p = p_pdf.begin(),
             cit_q = q_counter.begin();
@@ -197,12 +209,199 @@ private:
     FloatT x_very_first, x_very_last;
 };
 
+/**
+ * Same estimator as KLDS but P is stored in contiguous sorted arrays
+ * and Q may be given either as a pdf (Counter) or directly as a
+ * sorted sequence of samples, which avoids building a map for each
+ * Q.
+ *
+ * KL(P||Q) is evaluated by a single merge pass over P and Q. The sum
+ * of log(delta_p) is precomputed once for P, and the sum of the
+ * remaining log(delta_q) terms is obtained as the log of their
+ * product (kept normalized with frexp), so that evaluating Q costs a
+ * single call of std::log instead of one per component.
+ *
+ * All evaluation methods are const, so the same FlatKLDS can be
+ * shared across threads, see batch().
+ */
+template<typename FloatT>
+struct FlatKLDS {
+    typedef std::map<FloatT, FloatT> pdf_t;
+
+    FlatKLDS() : margin(1.0) {}
+
+    /**
+     * @param p sorted sequence of values representing the distribution of P
+     */
+    template<typename SortedSeq>
+    FlatKLDS(const SortedSeq& p) : margin(1.0) {
+        set_p(p);
+    }
+
+    /**
+     * @param p_counter mapping between values and number of
+     *                  occurrences (sampled according to P)
+     * @param p_s_      total number of observations of p_counter,
+     *                  automatically calculated if negative
+     */
+    FlatKLDS(const pdf_t& p_pdf, FloatT p_s_ = -1) : margin(1.0) {
+        set_p_pdf(p_pdf, p_s_);
+    }
+
+    void set_p_pdf(const pdf_t& p_counter, FloatT p_s_ = -1) {
+        p_x.clear();
+        delta_p.clear();
+        p_x.reserve(p_counter.size());
+        delta_p.reserve(p_counter.size());
+        for (const auto& v : p_counter) {
+            p_x.push_back(v.first);
+            delta_p.push_back(v.second);
+        }
+        p_s = p_s_ < 0 ? boost::accumulate(delta_p, FloatT(0)) : p_s_;
+        precompute_delta_p();
+    }
+
+    template<typename SortedSeq>
+    void set_p(const SortedSeq& p) {
+        p_x.clear();
+        delta_p.clear();
+        for (auto it = p.begin(); it != p.end(); ++it) {
+            if (p_x.empty() or p_x.back() < *it) {
+                p_x.push_back(*it);
+                delta_p.push_back(1);
+            } else
+                delta_p.back() += 1;
+        }
+        p_s = p.size();
+        precompute_delta_p();
+    }
+
+    //! size of p (duplicated values are not ignored)
+    size_t p_size() const {
+        return p_s;
+    }
+
+    //! size of the pdf of p (duplicated values are ignored)
+    size_t p_pdf_size() const {
+        return p_x.size();
+    }
+
+    //! @return estimate of KL(P||Q) given the pdf of Q
+    FloatT operator()(const pdf_t& q_counter) const {
+        return operator()(q_counter,
+                          boost::accumulate(q_counter | map_values, FloatT(0)));
+    }
+
+    //! like above but the total count q_s of q_counter is provided
+    FloatT operator()(const pdf_t& q_counter, FloatT q_s) const {
+        return kld(pdf_cursor(q_counter), q_s);
+    }
+
+    //! @return estimate of KL(P||Q) given a sorted sample [from, to) of Q
+    template<typename It>
+    FloatT operator()(It from, It to) const {
+        return kld(sorted_cursor<It>(from, to), std::distance(from, to));
+    }
+
+    //! like above, given a sorted sample of Q
+    FloatT operator()(const std::vector<FloatT>& q) const {
+        return operator()(q.begin(), q.end());
+    }
+
+    //! Compute KL(P||Q_i) for each Q_i of qs, in parallel. qs may
+    //! hold pdfs or sorted samples.
+    template<typename Qs>
+    std::vector<FloatT> batch(const Qs& qs) const {
+        std::vector<FloatT> res(qs.size());
+        parallel_transform(qs.begin(), qs.end(), res.begin(),
+                           [this](const typename Qs::value_type& q) {
+                               return (*this)(q); });
+        return res;
+    }
+
+private:
+    // Iterate over the distinct points of a pdf
+    struct pdf_cursor {
+        typedef typename pdf_t::const_iterator pdf_cit;
+        pdf_cursor(const pdf_t& pdf) : it(pdf.begin()), end(pdf.end()) {}
+        bool done() const { return it == end; }
+        FloatT x() const { return it->first; }
+        FloatT n() const { return it->second; }
+        void next() { ++it; }
+        pdf_cit it, end;
+    };
+
+    // Iterate over the distinct points of a sorted sample, counting
+    // the duplicates of each.
+    template<typename It>
+    struct sorted_cursor {
+        sorted_cursor(It from, It to) : it(from), run_end(from), end(to) {
+            skip_run();
+        }
+        bool done() const { return it == end; }
+        FloatT x() const { return *it; }
+        FloatT n() const { return run_n; }
+        void next() { it = run_end; skip_run(); }
+        void skip_run() {
+            run_n = 0;
+            while (run_end != end and not (*it < *run_end)) {
+                ++run_end;
+                ++run_n;
+            }
+        }
+        It it, run_end, end;
+        FloatT run_n;
+    };
+
+    // Merge P and Q, see KLDS::next for the per component formula.
+    template<typename Cursor>
+    FloatT kld(Cursor q, FloatT q_s) const {
+        FloatT q_x_pre = x_very_first, mant = 1;
+        long expo = 0;
+        for (FloatT px : p_x) {
+            FloatT q_x = q.done() ? x_very_last : q.x();
+            while (q_x < px) {
+                q_x_pre = q_x;
+                q.next();
+                q_x = q.done() ? x_very_last : q.x();
+            }
+            FloatT n_duplicates = q.done() ? 1.0 : q.n();
+            int e;
+            mant = std::frexp(mant * ((q_x - q_x_pre) / n_duplicates), &e);
+            expo += e;
+        }
+        FloatT log_q = std::log(mant) + expo * M_LN2,
+            res = sum_log_delta_p - p_x.size() * std::log(p_s / q_s) + log_q;
+        return res / p_s - 1;
+    }
+
+    //! replace the occurrence counts in delta_p by delta_p, and sum
+    //! their logs
+    void precompute_delta_p() {
+        OC_ASSERT(not p_x.empty(), "FlatKLDS: P must not be empty");
+        x_very_first = p_x.front() - margin;
+        x_very_last = p_x.back() + margin;
+        sum_log_delta_p = 0;
+        FloatT p_x_pre(x_very_first);
+        for (size_t i = 0; i < p_x.size(); ++i) {
+            delta_p[i] /= p_x[i] - p_x_pre;
+            sum_log_delta_p += std::log(delta_p[i]);
+            p_x_pre = p_x[i];
+        }
+    }
+
+    FloatT p_s, margin, sum_log_delta_p;
+
+    std::vector<FloatT> p_x, delta_p;
+    FloatT x_very_first, x_very_last;
+};
+
 //! function helper
 template<typename SortedSeq>
 typename SortedSeq::value_type KLD(const SortedSeq& p, const SortedSeq& q) {
     typedef typename SortedSeq::value_type FloatT;
-    KLDS<FloatT> klds(p);
-    return klds(Counter<FloatT, FloatT>(q));
+    FlatKLDS<FloatT> klds(p);
+    return klds(q.begin(), q.end());
 }
 
 ///@}
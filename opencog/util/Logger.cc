@@ -32,6 +32,7 @@
 #include <execinfo.h>
 #endif
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 
@@ -55,7 +56,9 @@
 #endif
 
 #include <opencog/util/backtrace-symbols.h>
+#include <opencog/util/metrics.h>
 #include <opencog/util/platform.h>
+#include <opencog/util/thread_placement.h>
 
 #include "Logger.h"
 
@@ -196,6 +199,7 @@ void Logger::LogWriter::stop_write_loop()
 void Logger::LogWriter::writing_loop()
 {
     set_thread_name("opencog:logger");
+    get_thread_placement("logger").apply();
 
     // When the thread exits, make sure that all pending messages have
     // been written to the logfile. This code is here because the usual
@@ -488,14 +492,32 @@ void Logger::disable()
     logEnabled = false;
 }
 
+// Number of messages logged by all loggers, per level
+static counter& messages_counter(Logger::Level level)
+{
+    static counter* counters[] = {
+        &metrics().get_counter("logger.messages.none"),
+        &metrics().get_counter("logger.messages.error"),
+        &metrics().get_counter("logger.messages.warn"),
+        &metrics().get_counter("logger.messages.info"),
+        &metrics().get_counter("logger.messages.debug"),
+        &metrics().get_counter("logger.messages.fine"),
+    };
+    return *counters[std::min<unsigned>(level, Logger::FINE)];
+}
+
 void Logger::log(Logger::Level level, const std::string &txt)
 {
     static const unsigned int max_queue_size_allowed = 1024;
+    static counter& full_queue_flushes =
+        metrics().get_counter("logger.full_queue_flushes");
     // Don't log if not enabled, or level is too low.
     if (!logEnabled) return;
     if (level > currentLevel) return;
     if (nullptr == _log_writer) return;
 
+    ++messages_counter(level);
+
     std::ostringstream oss;
     if (timestampEnabled)
     {
@@ -537,7 +559,10 @@ void Logger::log(Logger::Level level, const std::string &txt)
     // If the queue gets too full, block until it's flushed to
     // file. This can sometimes happen, if some component is spewing
     // lots of debugging messages in a tight loop.
-    if (_log_writer->size() > max_queue_size_allowed) flush();
+    if (_log_writer->size() > max_queue_size_allowed) {
+        ++full_queue_flushes;
+        flush();
+    }
 
     // Errors are associated with imminent crashes. Make sure that the
     // stack trace is written to disk *before* the crash happens! Yes,
@@ -23,10 +23,15 @@
 #ifndef _OPENCOG_MANNWHITNEYU_H
 #define _OPENCOG_MANNWHITNEYU_H
 
+#include <cmath>
+#include <iterator>
+#include <vector>
+
 #include <boost/range/numeric.hpp>
 #include <boost/range/adaptor/map.hpp>
 
 #include <opencog/util/Counter.h>
+#include <opencog/util/oc_omp.h>
 #include <opencog/util/ranking.h>
 
 namespace opencog {
@@ -50,12 +55,19 @@ FloatT MannWhitneyU(const Counter<Key, FloatT>& c1,
     counter_t r = ranking(c);
     FloatT sum2 = 0;
     for (const auto& v : c2)
-        sum2 += r[v.first];
+        sum2 += r[v.first] * v.second;
     if (n2 < 0)
-        n2 = boost::accumulate(c2 | map_values, 0);
+        n2 = c2.total_count();
     return sum2 - n2*(n2+1)/2;
 }
 
+//! like above but the size of c2 is obtained in O(1)
+template<typename Key, typename FloatT>
+FloatT MannWhitneyU(const TrackedCounter<Key, FloatT>& c1,
+                    const TrackedCounter<Key, FloatT>& c2) {
+    return MannWhitneyU<Key, FloatT>(c1, c2, c2.total_count());
+}
+
 /**
  * return the standardized Mann-Whitney U given 2 distributions
  * described by Counters
@@ -65,15 +77,89 @@ FloatT standardizedMannWhitneyU(const Counter<Key, FloatT>& c1,
                                 const Counter<Key, FloatT>& c2,
                                 FloatT n1 = -1, FloatT n2 = -1) {
     if(n1 < 0)
-        n1 = boost::accumulate(c1 | map_values, 0);
+        n1 = c1.total_count();
     if(n2 < 0)
-        n2 = boost::accumulate(c2 | map_values, 0);
+        n2 = c2.total_count();
     FloatT U = MannWhitneyU(c1, c2, n2),
         mU = n1*n2/2,
         sU = sqrt(mU*(n1+n2+1)/6);
     return (U - mU) / sU;
 }
 
+//! like above but the sizes of c1 and c2 are obtained in O(1)
+template<typename Key, typename FloatT>
+FloatT standardizedMannWhitneyU(const TrackedCounter<Key, FloatT>& c1,
+                                const TrackedCounter<Key, FloatT>& c2) {
+    return standardizedMannWhitneyU<Key, FloatT>(c1, c2, c1.total_count(),
+                                                 c2.total_count());
+}
+
+//! Result of a Mann-Whitney U test on raw samples
+template<typename FloatT>
+struct MannWhitneyUStats {
+    FloatT U;      //!< U_2, like MannWhitneyU
+    FloatT z;      //!< standardized U, with tie correction
+    FloatT ties;   //!< sum of t^3 - t over the groups of t tied values
+};
+
+/**
+ * Mann-Whitney U test of 2 sorted samples [from1, to1) and [from2,
+ * to2).
+ *
+ * The ranks of the pooled samples are computed in a single merge
+ * pass, tied values getting their average rank, without building any
+ * intermediate container. U is the same as returned by MannWhitneyU
+ * on the Counters of both samples; z differs from
+ * standardizedMannWhitneyU in that the variance of U is corrected for
+ * ties:
+ *
+ * var(U) = n1 n2 / 12 ((n + 1) - Sum (t^3 - t) / (n (n - 1)))
+ */
+template<typename It1, typename It2,
+         typename FloatT = typename std::iterator_traits<It1>::value_type>
+MannWhitneyUStats<FloatT> sortedMannWhitneyUTest(It1 from1, It1 to1,
+                                                 It2 from2, It2 to2) {
+    FloatT n1 = 0, n2 = 0, sum2 = 0, ties = 0, lrank = 1;
+    while (from1 != to1 or from2 != to2) {
+        // smallest value not ranked yet
+        auto v = from1 == to1 ? *from2
+            : from2 == to2 ? *from1
+            : std::min(*from1, *from2);
+        FloatT t1 = 0, t2 = 0;
+        for (; from1 != to1 and not (v < *from1); ++from1)
+            ++t1;
+        for (; from2 != to2 and not (v < *from2); ++from2)
+            ++t2;
+        FloatT t = t1 + t2;
+        sum2 += t2 * (2*lrank + t - 1) / 2;
+        ties += t*t*t - t;
+        lrank += t;
+        n1 += t1;
+        n2 += t2;
+    }
+
+    MannWhitneyUStats<FloatT> res;
+    res.U = sum2 - n2*(n2+1)/2;
+    res.ties = ties;
+    FloatT n = n1 + n2,
+        mU = n1*n2/2,
+        vU = n1*n2/12 * ((n+1) - (n > 1 ? ties / (n*(n-1)) : 0));
+    res.z = vU > 0 ? (res.U - mU) / std::sqrt(vU) : 0;
+    return res;
+}
+
+/**
+ * Like above but the samples do not need to be sorted. They are
+ * taken by copy and sorted with parallel_sort.
+ */
+template<typename FloatT>
+MannWhitneyUStats<FloatT> MannWhitneyUTest(std::vector<FloatT> s1,
+                                           std::vector<FloatT> s2) {
+    parallel_sort(s1.begin(), s1.end());
+    parallel_sort(s2.begin(), s2.end());
+    return sortedMannWhitneyUTest(s1.begin(), s1.end(), s2.begin(), s2.end());
+}
+
 /** @}*/
 } // ~namespace opencog
 
@@ -24,8 +24,13 @@
 
 #include "StringTokenizer.h"
 
+#include <algorithm>
 #include <cstring>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #include <opencog/util/exceptions.h>
 #include <opencog/util/oc_assert.h>
 
@@ -140,3 +145,114 @@ std::vector<std::string> AltStringTokenizer::without_empty() const
     return ret;
 }
 
+
+StringViewTokenizer::StringViewTokenizer(std::string_view str,
+                                         std::string_view delimiters,
+                                         bool keep_empty)
+    : _begin(str.data()), _end(str.data() + str.size()),
+      _keep_empty(keep_empty), _chars(delimiters)
+{
+    OC_ASSERT(not delimiters.empty(),
+              "StringViewTokenizer - delimiters should not be empty.");
+    _is_delim.fill(false);
+    for (char c : delimiters)
+        _is_delim[(unsigned char)c] = true;
+    reset();
+}
+
+StringViewTokenizer::StringViewTokenizer(std::string_view str,
+                                         const std::vector<std::string_view>& delimiters,
+                                         bool keep_empty)
+    : _begin(str.data()), _end(str.data() + str.size()),
+      _keep_empty(keep_empty), _strings(delimiters.begin(), delimiters.end()),
+      _next(delimiters.size())
+{
+    OC_ASSERT(not delimiters.empty(),
+              "StringViewTokenizer - delimiters should not be empty.");
+    for (std::string_view d : delimiters)
+        OC_ASSERT(not d.empty(),
+                  "StringViewTokenizer - delimiter should not be empty.");
+    _is_delim.fill(false);
+    reset();
+}
+
+void StringViewTokenizer::reset()
+{
+    _pos = _begin;
+    std::fill(_next.begin(), _next.end(), nullptr);
+}
+
+const char* StringViewTokenizer::find_delimiter(const char* from,
+                                                size_t& delim_size)
+{
+    if (not _strings.empty()) {
+        // Earliest occurrence of any delimiter string, the longest
+        // one in case of a tie. Only the strings whose next
+        // occurrence is unknown or behind from are searched again, so
+        // that a rare delimiter does not make each token rescan the
+        // rest of the buffer.
+        std::string_view rest(from, _end - from);
+        const char* best = _end;
+        delim_size = 0;
+        for (size_t i = 0; i < _strings.size(); ++i) {
+            const std::string& d = _strings[i];
+            if (_next[i] == nullptr or _next[i] < from) {
+                size_t p = rest.find(d);
+                _next[i] = p == std::string_view::npos ? _end : from + p;
+            }
+            if (_next[i] == _end)
+                continue;
+            if (_next[i] < best or (_next[i] == best and d.size() > delim_size)) {
+                best = _next[i];
+                delim_size = d.size();
+            }
+        }
+        return best;
+    }
+
+    delim_size = 1;
+    if (_chars.size() == 1) {
+        const void* p = memchr(from, _chars[0], _end - from);
+        return p ? (const char*)p : _end;
+    }
+#ifdef __SSE2__
+    if (_chars.size() <= 4) {
+        __m128i d[4];
+        for (size_t i = 0; i < 4; ++i)
+            d[i] = _mm_set1_epi8(_chars[std::min(i, _chars.size() - 1)]);
+        for (; from + 16 <= _end; from += 16) {
+            __m128i b = _mm_loadu_si128((const __m128i*)from);
+            __m128i eq = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(b, d[0]), _mm_cmpeq_epi8(b, d[1])),
+                _mm_or_si128(_mm_cmpeq_epi8(b, d[2]), _mm_cmpeq_epi8(b, d[3])));
+            int mask = _mm_movemask_epi8(eq);
+            if (mask)
+                return from + __builtin_ctz(mask);
+        }
+    }
+#endif
+    for (; from < _end; ++from)
+        if (_is_delim[(unsigned char)*from])
+            return from;
+    return _end;
+}
+
+bool StringViewTokenizer::next_token(std::string_view& tok)
+{
+    while (_pos != nullptr) {
+        size_t delim_size;
+        const char* stop = find_delimiter(_pos, delim_size);
+        tok = std::string_view(_pos, stop - _pos);
+        // Past the end if no delimiter was found
+        _pos = stop == _end ? nullptr : stop + delim_size;
+        if (_keep_empty or not tok.empty())
+            return true;
+    }
+    return false;
+}
+
+std::string_view StringViewTokenizer::next_token()
+{
+    std::string_view tok;
+    return next_token(tok) ? tok : std::string_view();
+}
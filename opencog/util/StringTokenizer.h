@@ -25,7 +25,10 @@
 #ifndef _OPENCOG_STRING_TOKENIZER_H
 #define _OPENCOG_STRING_TOKENIZER_H
 
+#include <array>
+#include <iterator>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace opencog
@@ -100,6 +103,121 @@ private:
 
 }; // class
 
+//! Tokenize a buffer without copying it
+/**
+ * The tokens are std::string_view's pointing into the caller's
+ * buffer, which must outlive them; no memory is allocated while
+ * tokenizing. The delimiters are copied, so temporaries are fine.
+ * Tokens are separated either by any character of a set (like
+ * AltStringTokenizer) or by any string of a set (like
+ * StringTokenizer, which only takes one). Empty tokens, between
+ * consecutive delimiters, are skipped unless keep_empty is true.
+ *
+ * Tokens can be read one at a time with next_token(), or iterated:
+ *
+ * for (std::string_view tok : StringViewTokenizer(buf, " \t\n"))
+ *     ...
+ *
+ * The search for a single delimiter character uses memchr, and that
+ * for a few delimiter characters compares 16 bytes at a time with
+ * SSE2 when available. Delimiter strings are each searched once per
+ * occurrence, so that the buffer is scanned once per string.
+ */
+class StringViewTokenizer
+{
+public:
+    class const_iterator
+    {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef std::string_view value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const std::string_view* pointer;
+        typedef const std::string_view& reference;
+
+        const_iterator() : _tok(nullptr), _done(true) {}
+        const_iterator(StringViewTokenizer* tok) : _tok(tok), _done(false)
+        {
+            ++*this;
+        }
+
+        reference operator*() const { return _cur; }
+        pointer operator->() const { return &_cur; }
+        const_iterator& operator++()
+        {
+            _done = not _tok->next_token(_cur);
+            return *this;
+        }
+        const_iterator operator++(int)
+        {
+            const_iterator tmp(*this);
+            ++*this;
+            return tmp;
+        }
+        //! Iterators are only equal when both are past the end
+        bool operator==(const const_iterator& other) const
+        {
+            return _done and other._done;
+        }
+        bool operator!=(const const_iterator& other) const
+        {
+            return not (*this == other);
+        }
+
+    private:
+        StringViewTokenizer* _tok;
+        std::string_view _cur;
+        bool _done;
+    };
+    typedef const_iterator iterator;
+
+    //! Tokens separated by any character of delimiters
+    StringViewTokenizer(std::string_view str,
+                        std::string_view delimiters = " ,\n",
+                        bool keep_empty = false);
+
+    //! Tokens separated by any string of delimiters
+    StringViewTokenizer(std::string_view str,
+                        const std::vector<std::string_view>& delimiters,
+                        bool keep_empty = false);
+
+    /**
+     * Set tok to the next token and return true, or return false if
+     * the end of the string is reached.
+     */
+    bool next_token(std::string_view& tok);
+
+    //! Return the next token, or an empty view at the end of the string
+    std::string_view next_token();
+
+    //! Restart from the beginning of the string
+    void reset();
+
+    //! Iterate over the remaining tokens
+    const_iterator begin() { return const_iterator(this); }
+    const_iterator end() { return const_iterator(); }
+
+private:
+    // Return the position of the first delimiter in [from, _end) and
+    // set delim_size to its size, or return _end.
+    const char* find_delimiter(const char* from, size_t& delim_size);
+
+    const char* _begin;
+    const char* _end;
+    // Start of the next token, nullptr when finished
+    const char* _pos;
+    bool _keep_empty;
+
+    // Delimiter characters, and whether each byte is one of them.
+    // Delimiters are copied, so they need not outlive the tokenizer.
+    std::string _chars;
+    std::array<bool, 256> _is_delim;
+    // Delimiter strings, if tokenizing on strings, and the position of
+    // the next occurrence of each, _end if none, nullptr if not known
+    std::vector<std::string> _strings;
+    std::vector<const char*> _next;
+};
+
 /** @}*/
 }  // namespace
 
@@ -2,7 +2,10 @@
 #define _OPENCOG_ALGORITHM_H
 
 #include <algorithm>
+#include <cstdint>
+#include <numeric>
 #include <set>
+#include <vector>
 #include <boost/bind/bind.hpp>
 
 #include <opencog/util/numeric.h>
@@ -258,6 +261,49 @@ Set set_symmetric_difference(const Set& s1, const Set& s2) {
 	return res;
 }
 
+/**
+ * \return the size of the intersection of [from1, to1) and [from2,
+ * to2), without building it. Both ranges must be sorted according to
+ * comp.
+ */
+template<typename It1, typename It2, typename Comp>
+size_t set_intersection_size(It1 from1, It1 to1,
+                             It2 from2, It2 to2, Comp comp)
+{
+	size_t res = 0;
+	while (from1 != to1 && from2 != to2) {
+		if (comp(*from1, *from2))
+			++from1;
+		else if (comp(*from2, *from1))
+			++from2;
+		else {
+			++res;
+			++from1;
+			++from2;
+		}
+	}
+	return res;
+}
+
+/**
+ * \return the size of s1 inter s2
+ * s1 and s2 must be sorted by operator<
+ */
+template<typename Set>
+size_t set_intersection_size(const Set& s1, const Set& s2) {
+	return set_intersection_size(s1.begin(), s1.end(), s2.begin(), s2.end(),
+	                             std::less<typename Set::value_type>());
+}
+
+/**
+ * \return the size of s1 union s2
+ * s1 and s2 must be sorted by operator<
+ */
+template<typename Set>
+size_t set_union_size(const Set& s1, const Set& s2) {
+	return s1.size() + s2.size() - set_intersection_size(s1, s2);
+}
+
 //! Predicate maps to the range [0, n)
 //! n-1 values (the pivots) are copied to out
 template<typename It, typename Pred, typename Out>
@@ -343,6 +389,113 @@ std::set<std::vector<typename C::value_type>> cartesian_product(const C& c,
 	return {{}};
 }
 
+/**
+ * Lazy enumeration of subsets and products.
+ *
+ * Unlike powerset and cartesian_product, the functions below do not
+ * build the whole result. They call f on each subset (or tuple) in
+ * turn, passing a buffer that is updated in place, so nothing is
+ * allocated per element. The buffer is only valid during the call
+ * of f; copy it if needed.
+ */
+
+//! Call f on the indices of each k-subset of {0, ..., n-1}, in
+//! lexicographic order. f takes a const std::vector<size_t>&.
+template<typename F>
+void for_each_combination(size_t n, size_t k, F f)
+{
+	if (k > n) return;
+	std::vector<size_t> idx(k);
+	for (size_t i = 0; i < k; ++i)
+		idx[i] = i;
+	while (true) {
+		f(idx);
+		// Find the rightmost index that can be incremented
+		size_t i = k;
+		while (i > 0 and idx[i-1] == n - k + i - 1)
+			--i;
+		if (i == 0) return;
+		++idx[i-1];
+		for (size_t j = i; j < k; ++j)
+			idx[j] = idx[j-1] + 1;
+	}
+}
+
+/**
+ * Call f on every subset of {0, ..., n-1} in Gray code order, that is
+ * each subset differs from the previous one by a single element.
+ * f takes the membership mask (const std::vector<bool>&) and the
+ * index that was flipped to reach it (n for the first, empty, subset).
+ */
+template<typename F>
+void for_each_gray_subset(size_t n, F f)
+{
+	OC_ASSERT(n < 64, "for_each_gray_subset: too many elements");
+	std::vector<bool> mask(n, false);
+	f(mask, n);
+	for (uint64_t i = 1; i < (uint64_t(1) << n); ++i) {
+		// The bit flipped by the i-th Gray code is the lowest set bit of i
+		size_t flipped = __builtin_ctzll(i);
+		mask[flipped] = not mask[flipped];
+		f(mask, flipped);
+	}
+}
+
+//! Call f on each subset of c of size k, as a const
+//! std::vector<value_type>&, in the lexicographic order of c.
+template<typename C, typename F>
+void for_each_subset(const C& c, size_t k, F f)
+{
+	std::vector<typename C::value_type> elems(c.begin(), c.end()), subset(k);
+	for_each_combination(elems.size(), k,
+		[&](const std::vector<size_t>& idx) {
+			for (size_t i = 0; i < k; ++i)
+				subset[i] = elems[idx[i]];
+			f(subset);
+		});
+}
+
+//! Call f on each tuple of the n-fold Cartesian product of c with
+//! itself, as a const std::vector<value_type>&, in lexicographic order.
+template<typename C, typename F>
+void for_each_product(const C& c, size_t nfold, F f)
+{
+	std::vector<typename C::value_type> elems(c.begin(), c.end());
+	if (elems.empty() and nfold > 0) return;
+	std::vector<size_t> odometer(nfold, 0);
+	std::vector<typename C::value_type> tuple(nfold, elems.empty() ?
+	                                          typename C::value_type() :
+	                                          elems[0]);
+	while (true) {
+		f(tuple);
+		size_t i = nfold;
+		while (i > 0 and odometer[i-1] + 1 == elems.size()) {
+			odometer[i-1] = 0;
+			tuple[i-1] = elems[0];
+			--i;
+		}
+		if (i == 0) return;
+		tuple[i-1] = elems[++odometer[i-1]];
+	}
+}
+
+//! Return the binomial coefficient n choose k, asserting that it fits
+//! in 64 bits.
+inline uint64_t binomial(uint64_t n, uint64_t k)
+{
+	if (k > n) return 0;
+	k = std::min(k, n - k);
+	uint64_t res = 1;
+	for (uint64_t i = 1; i <= k; ++i) {
+		// res * (n - k + i) is divisible by i
+		uint64_t g = std::gcd(res, i), r = res / g, d = i / g, m;
+		OC_ASSERT(not __builtin_mul_overflow(r, (n - k + i) / d, &m),
+		          "binomial: overflow");
+		res = m;
+	}
+	return res;
+}
+
 /**
  * Given a sequence of indexes, and a sequence of elements, return a
  * sequence of all elements corresponding to the indexes (in the order
@@ -36,6 +36,8 @@
 #include <opencog/util/exceptions.h>
 #include <opencog/util/Logger.h>
 #include <opencog/util/macros.h>
+#include <opencog/util/metrics.h>
+#include <opencog/util/thread_placement.h>
 
 namespace opencog
 {
@@ -121,10 +123,19 @@ class async_caller
 
 		void start_writer_thread();
 		void stop_writer_threads();
-		void write_loop();
+		void write_loop(unsigned);
 
 		void drain();
 
+		std::string _metrics_name;
+		histogram _drain_time;
+		void register_metrics();
+
+		// Held while the placement is applied, so that a thread
+		// starting during set_placement ends up with the new one
+		std::mutex _placement_mutex;
+		thread_placement _placement;
+
 	public:
 		async_caller(Writer*, void (Writer::*)(const Element&), int nthreads=4);
 		~async_caller();
@@ -133,6 +144,7 @@ class async_caller
 		void barrier();
 
 		void set_watermarks(size_t, size_t);
+		void set_placement(const thread_placement&);
 
 		// Utilities for monitoring performance.
 		// _item_count == number of items queued;
@@ -184,6 +196,10 @@ async_caller<Writer, Element>::async_caller(Writer* wr,
 
 	clear_stats();
 
+	_metrics_name = metrics().unique_name("async_caller");
+	register_metrics();
+	_placement = get_thread_placement(_metrics_name);
+
 	for (int i=0; i<nthreads; i++)
 		start_writer_thread();
 }
@@ -191,9 +207,27 @@ async_caller<Writer, Element>::async_caller(Writer* wr,
 template<typename Writer, typename Element>
 async_caller<Writer, Element>::~async_caller()
 {
+	metrics().remove(_metrics_name);
 	stop_writer_threads();
 }
 
+/// Publish the monitoring statistics in the metrics registry, under
+/// async_caller (async_caller#2 and so on for further instances).
+template<typename Writer, typename Element>
+void async_caller<Writer, Element>::register_metrics()
+{
+	MetricsRegistry& reg = metrics();
+	reg.add(_metrics_name + ".items", [this] { return (double) _item_count; });
+	reg.add(_metrics_name + ".flushes", [this] { return (double) _flush_count; });
+	reg.add(_metrics_name + ".drains", [this] { return (double) _drain_count; });
+	reg.add(_metrics_name + ".drain_msec", [this] { return (double) _drain_msec; });
+	reg.add(_metrics_name + ".drain_slowest_msec", [this] { return (double) _drain_slowest_msec; });
+	reg.add(_metrics_name + ".drain_concurrent", [this] { return (double) _drain_concurrent; });
+	reg.add(_metrics_name + ".pending", [this] { return (double) _pending; });
+	reg.add(_metrics_name + ".busy_writers", [this] { return (double) _busy_writers; });
+	reg.add(_metrics_name + ".drain_time_msec", _drain_time);
+}
+
 /// Set the high and low watermarks for processing. These are useful
 /// for preventing excessive backlogs of unprocessed elements from
 /// accumulating. When enqueueing new work, any threads that encounter
@@ -210,6 +244,20 @@ void async_caller<Writer, Element>::set_watermarks(size_t hi, size_t lo)
 	_low_watermark = lo;
 }
 
+/// Set where the writer threads run, see thread_placement. Applies
+/// to the running threads as well as to those started later. The
+/// initial placement is the one set for the metrics name of this
+/// instance (async_caller, async_caller#2...) by set_thread_placement().
+template<typename Writer, typename Element>
+void async_caller<Writer, Element>::set_placement(const thread_placement& tp)
+{
+	std::unique_lock<std::mutex> lock(_write_mutex);
+	std::lock_guard<std::mutex> plock(_placement_mutex);
+	_placement = tp;
+	for (size_t i = 0; i < _write_threads.size(); i++)
+		tp.apply(_write_threads[i].native_handle(), i);
+}
+
 template<typename Writer, typename Element>
 void async_caller<Writer, Element>::clear_stats()
 {
@@ -219,6 +267,7 @@ void async_caller<Writer, Element>::clear_stats()
 	_drain_msec = 0;
 	_drain_slowest_msec = 0;
 	_drain_concurrent = 0;
+	_drain_time.reset();
 }
 
 /* ================================================================ */
@@ -234,7 +283,8 @@ void async_caller<Writer, Element>::start_writer_thread()
 		throw RuntimeException(TRACE_INFO,
 			"Cannot start; async_caller writer threads are being stopped!");
 
-	_write_threads.push_back(std::thread(&async_caller::write_loop, this));
+	_write_threads.push_back(std::thread(&async_caller::write_loop, this,
+	                                     _thread_count));
 	_thread_count ++;
 }
 
@@ -351,8 +401,14 @@ void async_caller<Writer, Element>::barrier()
 /// A single write thread. Reads elements from queue, and invokes the
 /// method on them.
 template<typename Writer, typename Element>
-void async_caller<Writer, Element>::write_loop()
+void async_caller<Writer, Element>::write_loop(unsigned i)
 {
+	// Before allocating anything, so that it is on the local node
+	{
+		std::lock_guard<std::mutex> lock(_placement_mutex);
+		_placement.apply(i);
+	}
+
 	try
 	{
 		while (true)
@@ -463,6 +519,7 @@ void async_caller<Writer, Element>::enqueue(const Element& elt)
 		logger().debug("async_caller overfull queue; had to sleep %d millisecs to drain!", msec);
 		_drain_msec += msec;
 		if (_drain_slowest_msec < msec) _drain_slowest_msec = msec;
+		_drain_time.record(msec);
 	}
 }
 
@@ -0,0 +1,389 @@
+/*
+ * opencog/util/bitset_set.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_BITSET_SET_H
+#define _OPENCOG_BITSET_SET_H
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <vector>
+
+#include <opencog/util/algorithm.h>
+
+namespace opencog {
+/** \addtogroup grp_cogutil
+ *  @{
+ */
+
+/**
+ * Set of small non-negative integers stored as a bitset, one bit per
+ * element of the domain [0, domain_size()). The domain grows as
+ * elements are inserted.
+ *
+ * It behaves like a std::set<size_t> (iteration is in increasing
+ * order) but unions, intersections and differences are word-wise
+ * logical operations, and their sizes are popcounts, so that no
+ * result set needs to be built just to be measured. It pays off when
+ * the elements are dense in their domain, for instance indices of
+ * features or of data points.
+ */
+class bitset_set
+{
+public:
+    typedef size_t value_type;
+    typedef size_t key_type;
+    typedef size_t size_type;
+    typedef uint64_t word_type;
+
+    static constexpr size_t word_bits = 64;
+
+    /// Forward iterator over the elements, in increasing order
+    class const_iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef size_t value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const size_t* pointer;
+        typedef const size_t& reference;
+
+        const_iterator() : _words(nullptr), _n_words(0), _pos(0) {}
+        const_iterator(const word_type* words, size_t n_words, size_t pos)
+            : _words(words), _n_words(n_words), _pos(pos)
+        {
+            seek();
+        }
+
+        reference operator*() const { return _pos; }
+        pointer operator->() const { return &_pos; }
+
+        const_iterator& operator++()
+        {
+            ++_pos;
+            seek();
+            return *this;
+        }
+        const_iterator operator++(int)
+        {
+            const_iterator tmp(*this);
+            ++*this;
+            return tmp;
+        }
+
+        bool operator==(const const_iterator& other) const
+        {
+            return _pos == other._pos;
+        }
+        bool operator!=(const const_iterator& other) const
+        {
+            return _pos != other._pos;
+        }
+
+    private:
+        // Move _pos to the next element >= _pos, or to the end
+        void seek()
+        {
+            size_t w = _pos / word_bits;
+            if (w >= _n_words) {
+                _pos = _n_words * word_bits;
+                return;
+            }
+            word_type bits = _words[w] & (~word_type(0) << (_pos % word_bits));
+            while (bits == 0) {
+                if (++w == _n_words) {
+                    _pos = _n_words * word_bits;
+                    return;
+                }
+                bits = _words[w];
+            }
+            _pos = w * word_bits + __builtin_ctzll(bits);
+        }
+
+        const word_type* _words;
+        size_t _n_words;
+        size_t _pos;
+    };
+    typedef const_iterator iterator;
+
+    bitset_set() : _size(0) {}
+
+    //! Empty set whose domain is at least [0, domain_size)
+    explicit bitset_set(size_t domain_size)
+        : _words((domain_size + word_bits - 1) / word_bits, 0), _size(0) {}
+
+    template<typename It>
+    bitset_set(It from, It to) : _size(0) { insert(from, to); }
+
+    bitset_set(std::initializer_list<size_t> l) : _size(0)
+    {
+        insert(l.begin(), l.end());
+    }
+
+    //! Insert v, return true if it was not already in the set
+    bool insert(size_t v)
+    {
+        size_t w = v / word_bits;
+        if (w >= _words.size())
+            _words.resize(w + 1, 0);
+        word_type bit = word_type(1) << (v % word_bits);
+        if (_words[w] & bit)
+            return false;
+        _words[w] |= bit;
+        ++_size;
+        return true;
+    }
+
+    //! For std::inserter, the hint is ignored
+    const_iterator insert(const_iterator, size_t v)
+    {
+        insert(v);
+        return const_iterator(_words.data(), _words.size(), v);
+    }
+
+    template<typename It>
+    void insert(It from, It to)
+    {
+        for (; from != to; ++from)
+            insert(*from);
+    }
+
+    void insert(std::initializer_list<size_t> l)
+    {
+        insert(l.begin(), l.end());
+    }
+
+    //! Remove v, return the number of elements removed (0 or 1)
+    size_t erase(size_t v)
+    {
+        size_t w = v / word_bits;
+        if (w >= _words.size())
+            return 0;
+        word_type bit = word_type(1) << (v % word_bits);
+        if (not (_words[w] & bit))
+            return 0;
+        _words[w] &= ~bit;
+        --_size;
+        return 1;
+    }
+
+    bool contains(size_t v) const
+    {
+        size_t w = v / word_bits;
+        return w < _words.size()
+            and (_words[w] >> (v % word_bits)) & 1;
+    }
+
+    size_t count(size_t v) const { return contains(v); }
+
+    const_iterator find(size_t v) const
+    {
+        return contains(v) ? const_iterator(_words.data(), _words.size(), v)
+            : end();
+    }
+
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+    //! Remove all elements, keeping the domain
+    void clear()
+    {
+        std::fill(_words.begin(), _words.end(), 0);
+        _size = 0;
+    }
+
+    size_t domain_size() const { return _words.size() * word_bits; }
+
+    const_iterator begin() const
+    {
+        return const_iterator(_words.data(), _words.size(), 0);
+    }
+    const_iterator end() const
+    {
+        return const_iterator(_words.data(), _words.size(), domain_size());
+    }
+
+    const std::vector<word_type>& words() const { return _words; }
+
+    bitset_set& operator|=(const bitset_set& other)
+    {
+        if (_words.size() < other._words.size())
+            _words.resize(other._words.size(), 0);
+        const word_type* o = other._words.data();
+        word_type* w = _words.data();
+        size_t n = other._words.size();
+        #pragma omp simd
+        for (size_t i = 0; i < n; ++i)
+            w[i] |= o[i];
+        recount();
+        return *this;
+    }
+
+    bitset_set& operator&=(const bitset_set& other)
+    {
+        size_t n = std::min(_words.size(), other._words.size());
+        const word_type* o = other._words.data();
+        word_type* w = _words.data();
+        #pragma omp simd
+        for (size_t i = 0; i < n; ++i)
+            w[i] &= o[i];
+        std::fill(_words.begin() + n, _words.end(), 0);
+        recount();
+        return *this;
+    }
+
+    //! Set difference
+    bitset_set& operator-=(const bitset_set& other)
+    {
+        size_t n = std::min(_words.size(), other._words.size());
+        const word_type* o = other._words.data();
+        word_type* w = _words.data();
+        #pragma omp simd
+        for (size_t i = 0; i < n; ++i)
+            w[i] &= ~o[i];
+        recount();
+        return *this;
+    }
+
+    //! Symmetric difference
+    bitset_set& operator^=(const bitset_set& other)
+    {
+        if (_words.size() < other._words.size())
+            _words.resize(other._words.size(), 0);
+        const word_type* o = other._words.data();
+        word_type* w = _words.data();
+        size_t n = other._words.size();
+        #pragma omp simd
+        for (size_t i = 0; i < n; ++i)
+            w[i] ^= o[i];
+        recount();
+        return *this;
+    }
+
+    //! Two sets are equal if they have the same elements, regardless
+    //! of their domains
+    bool operator==(const bitset_set& other) const
+    {
+        if (_size != other._size)
+            return false;
+        size_t n = std::min(_words.size(), other._words.size());
+        return std::equal(_words.begin(), _words.begin() + n,
+                          other._words.begin());
+    }
+    bool operator!=(const bitset_set& other) const
+    {
+        return not (*this == other);
+    }
+
+    //! Number of bits set in the n words pointed by w
+    static size_t popcount(const word_type* w, size_t n)
+    {
+        size_t res = 0;
+        #pragma omp simd reduction(+:res)
+        for (size_t i = 0; i < n; ++i)
+            res += __builtin_popcountll(w[i]);
+        return res;
+    }
+
+private:
+    void recount()
+    {
+        _size = popcount(_words.data(), _words.size());
+    }
+
+    std::vector<word_type> _words;
+    size_t _size;
+};
+
+//! Size of s1 inter s2, without building it
+inline size_t set_intersection_size(const bitset_set& s1, const bitset_set& s2)
+{
+    const bitset_set::word_type *w1 = s1.words().data(),
+        *w2 = s2.words().data();
+    size_t n = std::min(s1.words().size(), s2.words().size()), res = 0;
+    #pragma omp simd reduction(+:res)
+    for (size_t i = 0; i < n; ++i)
+        res += __builtin_popcountll(w1[i] & w2[i]);
+    return res;
+}
+
+//! Size of s1 union s2, without building it
+inline size_t set_union_size(const bitset_set& s1, const bitset_set& s2)
+{
+    return s1.size() + s2.size() - set_intersection_size(s1, s2);
+}
+
+/** @name Overloads of the set algebra of algorithm.h for bitset_set */
+///@{
+
+inline void set_union_modify(bitset_set& s1, const bitset_set& s2)
+{
+    s1 |= s2;
+}
+
+inline bitset_set set_union(const bitset_set& s1, const bitset_set& s2)
+{
+    bitset_set res(s1);
+    return res |= s2;
+}
+
+inline bitset_set set_intersection(const bitset_set& s1, const bitset_set& s2)
+{
+    bitset_set res(s1);
+    return res &= s2;
+}
+
+inline bitset_set set_difference(const bitset_set& s1, const bitset_set& s2)
+{
+    bitset_set res(s1);
+    return res -= s2;
+}
+
+inline bitset_set set_symmetric_difference(const bitset_set& s1,
+                                           const bitset_set& s2)
+{
+    bitset_set res(s1);
+    return res ^= s2;
+}
+
+inline bool has_empty_intersection(const bitset_set& s1, const bitset_set& s2)
+{
+    const std::vector<bitset_set::word_type> &w1 = s1.words(),
+        &w2 = s2.words();
+    size_t n = std::min(w1.size(), w2.size());
+    for (size_t i = 0; i < n; ++i)
+        if (w1[i] & w2[i])
+            return false;
+    return true;
+}
+
+inline bool is_disjoint(const bitset_set& s1, const bitset_set& s2)
+{
+    return has_empty_intersection(s1, s2);
+}
+
+///@}
+
+/** @}*/
+} // ~namespace opencog
+
+#endif // _OPENCOG_BITSET_SET_H
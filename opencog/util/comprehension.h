@@ -30,8 +30,11 @@
 
 #include <boost/range/algorithm/transform.hpp>
 #include <boost/range/adaptor/filtered.hpp>
+#include <boost/range/adaptor/transformed.hpp>
 
 #include <opencog/util/functional.h>
+#include <opencog/util/oc_omp.h>
+#include <opencog/util/parallel_algorithm.h>
 
 namespace opencog {
 /** \addtogroup grp_cogutil
@@ -142,6 +145,110 @@ auto set_comp(const Container& c, const Function& func,
     return v;
 }
 
+/**
+ * Parallel comprehensions
+ *
+ * auto res = parallel_{vector,set}_comp(container, function, filter);
+ *
+ * give the same results as their sequential counterparts. The
+ * container is split in chunks, each processed in parallel (with
+ * parallel_run) into its own result, and the results are then
+ * concatenated (in order) or merged. function and filter are called
+ * concurrently, through const references, so must be thread safe.
+ * This only pays off if function or filter are expensive or the
+ * container very large.
+ */
+
+// Split [begin(c), end(c)) into chunks, apply func on the elements
+// satisfying filter and append them to the chunk's own container.
+template<typename Result, typename Container, typename Function,
+         typename Filter>
+std::vector<Result> comp_chunks(const Container& c, const Function& func,
+                                const Filter& filter)
+{
+    typedef typename Container::const_iterator It;
+    size_t n = std::distance(c.begin(), c.end());
+    std::vector<std::pair<uint64_t, uint64_t>> ranges =
+        split_parallel_range(n);
+    std::vector<It> starts;
+    It it = c.begin();
+    uint64_t pos = 0;
+    for (const auto& r : ranges) {
+        std::advance(it, r.first - pos);
+        pos = r.first;
+        starts.push_back(it);
+    }
+
+    std::vector<Result> results(ranges.size());
+    parallel_run(ranges.size(), [&](size_t i) {
+            It it = starts[i];
+            for (uint64_t j = ranges[i].first; j < ranges[i].second; ++j, ++it)
+                if (filter(*it))
+                    results[i].insert(results[i].end(), func(*it));
+        });
+    return results;
+}
+
+//! parallel vector comprehension
+template<typename Container, typename Function, typename Filter=const_bool>
+auto parallel_vector_comp(const Container& c, const Function& func,
+                          const Filter& filter=default_filter)
+    -> std::vector<decltype(func(std::declval<typename Container::value_type>()))>
+{
+    typedef std::vector<decltype(func(std::declval<typename Container::value_type>()))> Result;
+    std::vector<Result> chunks = comp_chunks<Result>(c, func, filter);
+    size_t size = 0;
+    for (const Result& r : chunks)
+        size += r.size();
+    Result v;
+    v.reserve(size);
+    for (Result& r : chunks)
+        std::move(r.begin(), r.end(), std::back_inserter(v));
+    return v;
+}
+
+//! parallel set comprehension
+template<typename Container, typename Function, typename Filter=const_bool>
+auto parallel_set_comp(const Container& c, const Function& func,
+                       const Filter& filter=default_filter)
+    -> std::set<decltype(func(std::declval<typename Container::value_type>()))>
+{
+    typedef std::set<decltype(func(std::declval<typename Container::value_type>()))> Result;
+    std::vector<Result> chunks = comp_chunks<Result>(c, func, filter);
+    Result s;
+    for (Result& r : chunks) {
+        if (s.empty())
+            s.swap(r);
+        else
+            s.insert(r.begin(), r.end());
+    }
+    return s;
+}
+
+/**
+ * Lazy comprehension
+ *
+ * auto view = lazy_comp(container, function, filter);
+ *
+ * returns a range over function(x) for each x of container satisfying
+ * filter, evaluated on iteration; nothing is allocated. Views can be
+ * chained, and passed to the comprehensions above to materialize the
+ * final result, for instance
+ *
+ * auto res = vector_comp(lazy_comp(c, f, p), g);
+ *
+ * builds no intermediate container. The view refers to container,
+ * which must outlive it, and function is evaluated at each
+ * dereference.
+ */
+template<typename Container, typename Function, typename Filter=const_bool>
+auto lazy_comp(const Container& c, const Function& func,
+               const Filter& filter=default_filter)
+{
+    return c | boost::adaptors::filtered(filter)
+        | boost::adaptors::transformed(func);
+}
+
 }
 
 ///@}
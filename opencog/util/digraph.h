@@ -23,13 +23,21 @@
 #ifndef _OPENCOG_DIGRAPH_H
 #define _OPENCOG_DIGRAPH_H
 
-#include <queue>
+#include <atomic>
+#include <iterator>
+#include <numeric>
 #include <vector>
 #include <set>
 #include <opencog/util/algorithm.h>
 #include <opencog/util/exceptions.h>
 #include <opencog/util/oc_assert.h>
+#include <opencog/util/oc_omp.h>
+#include <opencog/util/parallel_algorithm.h>
+#include <opencog/util/mt19937ar.h>
+#include <opencog/util/RandGen.h>
 #include <boost/iterator/counting_iterator.hpp>
+#include <boost/range/iterator_range.hpp>
+#include <boost/range/size.hpp>
 
 namespace opencog
 {
@@ -44,17 +52,17 @@ struct digraph {
     typedef std::set<value_type> value_set;
 
     //! construct an empty digraph of size n
-    digraph(size_type n) : _incoming(n), _outgoing(n) { }
+    digraph(size_type n) : _incoming(n), _outgoing(n), _n_edges(0) { }
 
     //! insert an arc outgoing from src to dst
     void insert(value_type src, value_type dst) {
         _incoming[dst].insert(src);
-        _outgoing[src].insert(dst);
+        _n_edges += _outgoing[src].insert(dst).second;
     }
     //! erase the arc outgoing from src to dst
     void erase(value_type src, value_type dst) {
         _incoming[dst].erase(src);
-        _outgoing[src].erase(dst);
+        _n_edges -= _outgoing[src].erase(dst);
     }
     //! return the number of nodes
     size_type n_nodes() const {
@@ -62,7 +70,7 @@ struct digraph {
     }
     //! return the number of edges
     size_type n_edges() const {
-        return accumulate2d(_incoming.begin(), _incoming.end(), size_type(0));
+        return _n_edges;
     }
     bool empty() const {
         return (n_edges() == 0);
@@ -78,43 +86,317 @@ struct digraph {
 protected:
     std::vector<value_set> _incoming;
     std::vector<value_set> _outgoing;
+    size_type _n_edges;
 };
 
-//! Fill 'out' with a list of nodes ordered according to a topological sort of g.
 /**
- * It is assumed that g is a dag, an assert is raised
- * otherwise.
+ * Immutable directed graph in compressed sparse row (CSR) format.
+ *
+ * The successors of all nodes are stored in one array, those of node
+ * x being at [offsets[x], offsets[x+1]), and likewise for the
+ * predecessors. Compared to digraph it takes two integers per edge
+ * instead of two set nodes, counting edges is O(1) and iterating
+ * over the successors of a node is a linear scan. It is meant to be
+ * built once, from a digraph or a list of edges, then traversed.
  */
-template<typename Out>
-Out randomized_topological_sort(digraph g, Out out)
+class csr_digraph {
+public:
+    typedef digraph::size_type size_type;
+    typedef digraph::value_type value_type;
+    typedef std::pair<value_type, value_type> edge;
+    typedef boost::iterator_range<const value_type*> value_range;
+
+    //! build a CSR digraph with n nodes from a list of edges
+    //! (src, dst). Duplicate edges are ignored.
+    csr_digraph(size_type n, const std::vector<edge>& edges)
+        : _out_offsets(n + 1, 0), _in_offsets(n + 1, 0)
+    {
+        // Counting sort of the edges by source
+        for (const edge& e : edges) {
+            OC_ASSERT(e.first < n and e.second < n,
+                      "csr_digraph - edge (%u, %u) out of range",
+                      e.first, e.second);
+            ++_out_offsets[e.first + 1];
+        }
+        std::partial_sum(_out_offsets.begin(), _out_offsets.end(),
+                         _out_offsets.begin());
+        _outgoing.resize(edges.size());
+        std::vector<size_t> pos(_out_offsets.begin(), _out_offsets.end() - 1);
+        for (const edge& e : edges)
+            _outgoing[pos[e.first]++] = e.second;
+
+        // Sort and remove duplicates in each row, compacting in place
+        size_t w = 0;
+        for (size_type x = 0; x < n; ++x) {
+            auto from = _outgoing.begin() + _out_offsets[x],
+                to = _outgoing.begin() + _out_offsets[x + 1];
+            std::sort(from, to);
+            to = std::unique(from, to);
+            _out_offsets[x] = w;
+            w = std::copy(from, to, _outgoing.begin() + w) - _outgoing.begin();
+        }
+        _out_offsets[n] = w;
+        _outgoing.resize(w);
+        _outgoing.shrink_to_fit();
+
+        build_incoming();
+    }
+
+    //! build a CSR digraph from a digraph
+    csr_digraph(const digraph& g)
+        : _out_offsets(g.n_nodes() + 1, 0), _in_offsets(g.n_nodes() + 1, 0)
+    {
+        _outgoing.reserve(g.n_edges());
+        for (size_type x = 0; x < g.n_nodes(); ++x) {
+            _outgoing.insert(_outgoing.end(),
+                             g.outgoing(x).begin(), g.outgoing(x).end());
+            _out_offsets[x + 1] = _outgoing.size();
+        }
+        build_incoming();
+    }
+
+    //! return the number of nodes
+    size_type n_nodes() const {
+        return _out_offsets.size() - 1;
+    }
+    //! return the number of edges
+    size_t n_edges() const {
+        return _outgoing.size();
+    }
+    bool empty() const {
+        return n_edges() == 0;
+    }
+    //! return the direct successors of x, in increasing order
+    value_range outgoing(value_type x) const {
+        return row(_outgoing, _out_offsets, x);
+    }
+    //! return the direct predecessors of x, in increasing order
+    value_range incoming(value_type x) const {
+        return row(_incoming, _in_offsets, x);
+    }
+    size_type out_degree(value_type x) const {
+        return _out_offsets[x + 1] - _out_offsets[x];
+    }
+    size_type in_degree(value_type x) const {
+        return _in_offsets[x + 1] - _in_offsets[x];
+    }
+
+protected:
+    static value_range row(const std::vector<value_type>& adj,
+                           const std::vector<size_t>& offsets, value_type x) {
+        return value_range(adj.data() + offsets[x], adj.data() + offsets[x + 1]);
+    }
+
+    // Transpose the outgoing rows. Since the sources are visited in
+    // increasing order each incoming row comes out sorted.
+    void build_incoming() {
+        size_type n = n_nodes();
+        for (value_type dst : _outgoing)
+            ++_in_offsets[dst + 1];
+        std::partial_sum(_in_offsets.begin(), _in_offsets.end(),
+                         _in_offsets.begin());
+        _incoming.resize(_outgoing.size());
+        std::vector<size_t> pos(_in_offsets.begin(), _in_offsets.end() - 1);
+        for (size_type src = 0; src < n; ++src)
+            for (value_type dst : outgoing(src))
+                _incoming[pos[dst]++] = src;
+    }
+
+    std::vector<size_t> _out_offsets, _in_offsets;
+    std::vector<value_type> _outgoing, _incoming;
+};
+
+// Output the nodes of g in a random topological order, given the
+// in-degree of each node and the nodes of in-degree 0 (ready), both
+// consumed in the process.
+template<typename Graph, typename Out>
+Out random_topological_walk(const Graph& g,
+                            std::vector<typename Graph::size_type>& in_degree,
+                            std::vector<typename Graph::value_type>& ready,
+                            Out out, RandGen& rng)
 {
-    typedef digraph::value_type value_t;
-    std::vector<value_t>
-        nodes(boost::make_counting_iterator(digraph::size_type(0)),
-              boost::make_counting_iterator(g.n_nodes()));
-    /// @todo replace default random generator by OpenCog's RandGen
-    std::random_shuffle(nodes.begin(), nodes.end());
-    std::queue<value_t> q;
-
-    for (value_t node : nodes)
-        if (g.incoming(node).empty())
-            q.push(node);
-
-    while (!q.empty()) {
-        value_t src = q.front();
-        q.pop();
+    typedef typename Graph::value_type value_t;
+    typename Graph::size_type n_sorted = 0;
+    while (!ready.empty()) {
+        // Draw a ready node and remove it by swapping with the last
+        size_t i = rng.randint(ready.size());
+        value_t src = ready[i];
+        ready[i] = ready.back();
+        ready.pop_back();
 
         *out++ = src;
+        ++n_sorted;
 
-        std::vector<value_t> outgoing(g.outgoing(src).begin(),
-                                      g.outgoing(src).end());
-        for (value_t dst : outgoing) {
-            g.erase(src, dst);
-            if (g.incoming(dst).empty())
-                q.push(dst);
+        for (value_t dst : g.outgoing(src))
+            if (--in_degree[dst] == 0)
+                ready.push_back(dst);
+    }
+    OC_ASSERT(n_sorted == g.n_nodes(), "digraph - g must be a DAG.");
+    return out;
+}
+
+//! Fill 'out' with a list of nodes ordered according to a random
+//! topological sort of g.
+/**
+ * At each step the next node is drawn uniformly, using rng, among
+ * the nodes whose predecessors have all been output. g, a digraph or
+ * a csr_digraph, is not modified. It is assumed that g is a dag, an
+ * assert is raised otherwise.
+ */
+template<typename Graph, typename Out>
+Out randomized_topological_sort(const Graph& g, Out out,
+                                RandGen& rng = randGen())
+{
+    typedef typename Graph::value_type value_t;
+    std::vector<typename Graph::size_type> in_degree(g.n_nodes());
+    std::vector<value_t> ready;
+    for (value_t x = 0; x < g.n_nodes(); ++x) {
+        in_degree[x] = boost::size(g.incoming(x));
+        if (in_degree[x] == 0)
+            ready.push_back(x);
+    }
+    return random_topological_walk(g, in_degree, ready, out, rng);
+}
+
+/**
+ * Generate many random topological orders of the same DAG. The
+ * in-degrees and sources are computed once at construction, each
+ * order then only costs a copy of them plus the traversal, and
+ * several orders can be drawn in parallel, each with its own random
+ * generator. g must outlive the sampler.
+ */
+class topological_order_sampler {
+public:
+    typedef csr_digraph::value_type value_type;
+    typedef std::vector<value_type> order;
+
+    topological_order_sampler(const csr_digraph& g)
+        : _g(g), _in_degree(g.n_nodes())
+    {
+        for (value_type x = 0; x < g.n_nodes(); ++x) {
+            _in_degree[x] = g.in_degree(x);
+            if (_in_degree[x] == 0)
+                _sources.push_back(x);
         }
     }
-    OC_ASSERT(g.empty(), "digraph - g must be a DAG."); // must be a dag
+
+    //! Fill 'out' with a random topological order, drawn with rng
+    template<typename Out>
+    Out operator()(Out out, RandGen& rng = randGen()) const
+    {
+        std::vector<csr_digraph::size_type> in_degree(_in_degree);
+        std::vector<value_type> ready(_sources);
+        return random_topological_walk(_g, in_degree, ready, out, rng);
+    }
+
+    /**
+     * Return k random topological orders, computed in parallel. The
+     * i-th order is drawn with a MT19937RandGen seeded with seed + i,
+     * so the result only depends on seed, not on the number of
+     * threads.
+     */
+    std::vector<order> operator()(unsigned k, unsigned long seed) const
+    {
+        std::vector<order> orders(k);
+        parallel_run(k, [&](size_t i) {
+                MT19937RandGen rng(seed + i);
+                orders[i].reserve(_g.n_nodes());
+                (*this)(std::back_inserter(orders[i]), rng);
+            });
+        return orders;
+    }
+
+private:
+    const csr_digraph& _g;
+    std::vector<csr_digraph::size_type> _in_degree;
+    std::vector<value_type> _sources;
+};
+
+//! Fill 'out' with the nodes of g in topological order.
+/**
+ * Kahn's algorithm, counting the remaining in-degree of each node;
+ * ties are broken in increasing node order. It is assumed that g is
+ * a dag, an assert is raised otherwise.
+ */
+template<typename Out>
+Out topological_sort(const csr_digraph& g, Out out)
+{
+    typedef csr_digraph::value_type value_t;
+    std::vector<csr_digraph::size_type> in_degree(g.n_nodes());
+    std::vector<value_t> ready;
+    ready.reserve(g.n_nodes());
+    for (value_t x = 0; x < g.n_nodes(); ++x) {
+        in_degree[x] = g.in_degree(x);
+        if (in_degree[x] == 0)
+            ready.push_back(x);
+    }
+    // ready is used as a FIFO queue, each node is pushed once
+    for (size_t i = 0; i < ready.size(); ++i)
+        for (value_t dst : g.outgoing(ready[i]))
+            if (--in_degree[dst] == 0)
+                ready.push_back(dst);
+
+    OC_ASSERT(ready.size() == g.n_nodes(), "digraph - g must be a DAG.");
+    return std::copy(ready.begin(), ready.end(), out);
+}
+
+/**
+ * Return the nodes of g partitioned in levels: level 0 holds the
+ * sources, and level i + 1 the nodes whose predecessors are all in
+ * levels 0 to i. Concatenating the levels gives a topological order.
+ *
+ * The nodes of a level are independent, so each level is processed
+ * in parallel, in chunks handed to parallel_run, with atomic
+ * in-degree counters. This only pays off on very large DAGs with
+ * wide levels. The order of the nodes within a level is unspecified.
+ * It is assumed that g is a dag, an assert is raised otherwise.
+ */
+inline std::vector<std::vector<csr_digraph::value_type>>
+topological_levels(const csr_digraph& g)
+{
+    typedef csr_digraph::value_type value_t;
+    std::vector<std::atomic<csr_digraph::size_type>> in_degree(g.n_nodes());
+    std::vector<std::vector<value_t>> levels(1);
+    for (value_t x = 0; x < g.n_nodes(); ++x) {
+        in_degree[x].store(g.in_degree(x), std::memory_order_relaxed);
+        if (g.in_degree(x) == 0)
+            levels[0].push_back(x);
+    }
+
+    size_t n_sorted = levels[0].size();
+    while (true) {
+        const std::vector<value_t>& level = levels.back();
+        std::vector<std::pair<uint64_t, uint64_t>> chunks =
+            split_parallel_range(level.size());
+        std::vector<std::vector<value_t>> next(chunks.size());
+        parallel_run(chunks.size(), [&](size_t c) {
+                for (uint64_t i = chunks[c].first; i < chunks[c].second; ++i)
+                    for (value_t dst : g.outgoing(level[i]))
+                        if (in_degree[dst].fetch_sub(1, std::memory_order_relaxed) == 1)
+                            next[c].push_back(dst);
+            });
+
+        std::vector<value_t> next_level;
+        for (const std::vector<value_t>& v : next)
+            next_level.insert(next_level.end(), v.begin(), v.end());
+        if (next_level.empty())
+            break;
+        n_sorted += next_level.size();
+        levels.push_back(std::move(next_level));
+    }
+    OC_ASSERT(n_sorted == g.n_nodes(), "digraph - g must be a DAG.");
+    if (levels.back().empty())
+        levels.pop_back();
+    return levels;
+}
+
+//! Fill 'out' with the nodes of g in topological order, processing
+//! each level in parallel. See topological_levels.
+template<typename Out>
+Out parallel_topological_sort(const csr_digraph& g, Out out)
+{
+    for (const auto& level : topological_levels(g))
+        out = std::copy(level.begin(), level.end(), out);
     return out;
 }
 
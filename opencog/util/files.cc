@@ -20,16 +20,21 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 
 #include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/wait.h>
 
 #include <string.h>
 #include <stdlib.h>
 
+#include "exceptions.h"
 #include "files.h"
 #include "platform.h"
 
@@ -150,47 +155,305 @@ bool opencog::create_directory(const char* directory)
 
 bool opencog::append_file_content(const char* filename, std::string &s)
 {
-    std::ifstream in(filename);
-    if (!in.is_open())
+    return read_file(filename, s);
+}
+
+bool opencog::load_text_file(const std::string &fname, std::string& dest)
+{
+    if (not read_file(fname, dest)) {
+        puts("File not found.");
         return false;
+    }
+    // Text is cut at the first null character, as it used to be
+    dest.resize(strnlen(dest.data(), dest.size()));
+    return true;
+}
 
-    char c;
-    std::string str;
-    while (in.get(c))
-        str += c;
+bool opencog::read_file(const std::string& fname, std::string& dest)
+{
+    int fd = open(fname.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
 
-    if (!in.eof())
+    struct stat st;
+    if (fstat(fd, &st) < 0 or S_ISDIR(st.st_mode)) {
+        close(fd);
         return false;
+    }
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
 
-    s = str;
+    // Start with the size of the file, if known, and grow if it
+    // happens to be larger (or unknown). When the buffer is full,
+    // probe for the end of the file before growing it, so that a file
+    // of the expected size is not copied again.
+    const size_t block = 1 << 20;
+    std::string buf;
+    buf.resize(S_ISREG(st.st_mode) and st.st_size > 0 ? st.st_size : block);
+    size_t len = 0;
+    char probe[4096];
+    while (true) {
+        bool full = len == buf.size();
+        ssize_t r = full ? read(fd, probe, sizeof(probe))
+            : read(fd, &buf[len], buf.size() - len);
+        if (r < 0) {
+            if (errno == EINTR)
+                continue;
+            close(fd);
+            return false;
+        }
+        if (r == 0)
+            break;
+        if (full) {
+            buf.resize(buf.size() + std::max(block, buf.size() / 2));
+            memcpy(&buf[len], probe, r);
+        }
+        len += r;
+    }
+    close(fd);
+    buf.resize(len);
+    dest.swap(buf);
     return true;
 }
 
-bool opencog::load_text_file(const std::string &fname, std::string& dest)
+static int madvise_flag(opencog::mapped_file::access_hint hint)
 {
-    FILE *f = fopen(fname.c_str(), "rt");
-    if (f == NULL) {
-        puts("File not found.");
-        return false;
+    switch (hint) {
+    case opencog::mapped_file::sequential: return MADV_SEQUENTIAL;
+    case opencog::mapped_file::random: return MADV_RANDOM;
+    default: return MADV_NORMAL;
     }
-    fseek(f, 0L, SEEK_END);
-    long fsize = ftell(f);
-    fseek(f, 0L, SEEK_SET);
+}
 
-    char *buf = new char[fsize+2];
-    long bptr = 0;
+opencog::mapped_file::mapped_file(const std::string& fname, access_hint hint)
+    : _data(nullptr), _size(0)
+{
+    int fd = open(fname.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw IOException(TRACE_INFO, "mapped_file - cannot open %s: %s",
+                          fname.c_str(), strerror(errno));
+    struct stat st;
+    if (fstat(fd, &st) < 0 or not S_ISREG(st.st_mode)) {
+        close(fd);
+        throw IOException(TRACE_INFO, "mapped_file - %s is not a regular file",
+                          fname.c_str());
+    }
+    // An empty file cannot be mapped, it is represented by an empty view
+    if (st.st_size > 0) {
+        void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            int err = errno;
+            close(fd);
+            throw IOException(TRACE_INFO, "mapped_file - cannot map %s: %s",
+                              fname.c_str(), strerror(err));
+        }
+        _data = (const char*)p;
+        _size = st.st_size;
+        advise(hint);
+    }
+    // The mapping remains valid after the descriptor is closed
+    close(fd);
+}
 
-    while (!feof(f))
-        buf[bptr++] = getc(f);
-// fread(buf, 8000, 1+(fsize/8000), f);
-    buf[bptr] = '\0';
+opencog::mapped_file::~mapped_file()
+{
+    unmap();
+}
 
-    fclose(f);
+opencog::mapped_file::mapped_file(mapped_file&& other)
+    : _data(other._data), _size(other._size)
+{
+    other._data = nullptr;
+    other._size = 0;
+}
+
+opencog::mapped_file& opencog::mapped_file::operator=(mapped_file&& other)
+{
+    if (this != &other) {
+        unmap();
+        _data = other._data;
+        _size = other._size;
+        other._data = nullptr;
+        other._size = 0;
+    }
+    return *this;
+}
+
+void opencog::mapped_file::advise(access_hint hint)
+{
+    if (_size > 0)
+        madvise((void*)_data, _size, madvise_flag(hint));
+}
+
+void opencog::mapped_file::will_need(size_t offset, size_t length)
+{
+    if (offset >= _size)
+        return;
+    // madvise requires a page aligned address
+    size_t page = sysconf(_SC_PAGESIZE), start = offset - offset % page;
+    length = std::min(length, _size - offset) + (offset - start);
+    madvise((void*)(_data + start), length, MADV_WILLNEED);
+}
+
+void opencog::mapped_file::unmap()
+{
+    if (_data)
+        munmap((void*)_data, _size);
+    _data = nullptr;
+    _size = 0;
+}
+
+opencog::file_source::file_source(const std::string& fname)
+{
+    _fd = open(fname.c_str(), O_RDONLY);
+    if (_fd < 0)
+        throw IOException(TRACE_INFO, "file_source - cannot open %s: %s",
+                          fname.c_str(), strerror(errno));
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+}
+
+opencog::file_source::~file_source()
+{
+    close(_fd);
+}
 
-    dest = buf;
+size_t opencog::file_source::read(char* buf, size_t size)
+{
+    while (true) {
+        ssize_t r = ::read(_fd, buf, size);
+        if (r >= 0)
+            return r;
+        if (errno != EINTR)
+            throw IOException(TRACE_INFO, "file_source - read failed: %s",
+                              strerror(errno));
+    }
+}
 
-    delete[] buf;
+opencog::command_source::command_source(const std::string& command)
+    : _command(command)
+{
+    _pipe = popen(command.c_str(), "r");
+    if (_pipe == NULL)
+        throw IOException(TRACE_INFO, "command_source - cannot run %s: %s",
+                          command.c_str(), strerror(errno));
+}
 
+opencog::command_source::~command_source()
+{
+    if (_pipe)
+        pclose(_pipe);
+}
+
+size_t opencog::command_source::read(char* buf, size_t size)
+{
+    if (_pipe == NULL)
+        return 0;
+    size_t r = fread(buf, 1, size, _pipe);
+    if (r == 0 and ferror(_pipe))
+        throw IOException(TRACE_INFO, "command_source - cannot read from %s",
+                          _command.c_str());
+    if (r == 0 and size > 0) {
+        // End of the output, check that it is complete
+        int status = pclose(_pipe);
+        _pipe = NULL;
+        if (status == -1 or not WIFEXITED(status) or WEXITSTATUS(status) != 0)
+            throw IOException(TRACE_INFO, "command_source - %s failed "
+                              "(status %d), its output is incomplete",
+                              _command.c_str(), status);
+    }
+    return r;
+}
+
+std::unique_ptr<opencog::byte_source>
+opencog::open_byte_source(const std::string& fname)
+{
+    static const std::vector<std::pair<std::string, std::string>> programs =
+    {
+        {".gz", "gzip -dc "},
+        {".bz2", "bzip2 -dc "},
+        {".xz", "xz -dc "},
+        {".zst", "zstd -dc "},
+    };
+    for (const auto& p : programs) {
+        const std::string& ext = p.first;
+        if (fname.size() > ext.size() and
+            fname.compare(fname.size() - ext.size(), ext.size(), ext) == 0)
+        {
+            // popen does not tell whether the file exists
+            if (not exists(fname.c_str()))
+                throw IOException(TRACE_INFO,
+                                  "open_byte_source - cannot open %s",
+                                  fname.c_str());
+            // Single quote the file name for the shell
+            std::string quoted = "'";
+            for (char c : fname)
+                quoted += c == '\'' ? std::string("'\\''") : std::string(1, c);
+            quoted += "'";
+            return std::unique_ptr<byte_source>(
+                new command_source(p.second + quoted));
+        }
+    }
+    return std::unique_ptr<byte_source>(new file_source(fname));
+}
+
+opencog::chunked_line_reader::chunked_line_reader(const std::string& fname,
+                                                  size_t chunk_size)
+    : chunked_line_reader(open_byte_source(fname), chunk_size) {}
+
+opencog::chunked_line_reader::chunked_line_reader(std::unique_ptr<byte_source> source,
+                                                  size_t chunk_size)
+    : _source(std::move(source)), _chunk_size(std::max<size_t>(chunk_size, 1)),
+      _eof(false), _line_pos(0) {}
+
+bool opencog::chunked_line_reader::next_chunk(std::string& chunk)
+{
+    chunk.swap(_carry);
+    _carry.clear();
+    if (_eof)
+        return not chunk.empty();
+
+    // Read until the chunk is full and holds a newline
+    size_t scanned = 0;
+    while (true) {
+        size_t len = chunk.size();
+        if (len >= _chunk_size) {
+            // Only the bytes read since the last search can hold a newline
+            size_t eol = std::string_view(chunk).substr(scanned).rfind('\n');
+            if (eol != std::string::npos) {
+                eol += scanned;
+                _carry.assign(chunk, eol + 1, std::string::npos);
+                chunk.resize(eol + 1);
+                return true;
+            }
+            scanned = len;
+        }
+        // Grow by at least one byte, however small the chunks are
+        chunk.resize(std::max(len + std::max<size_t>(1, _chunk_size / 4),
+                              _chunk_size));
+        size_t r = _source->read(&chunk[len], chunk.size() - len);
+        chunk.resize(len + r);
+        if (r == 0) {
+            _eof = true;
+            return not chunk.empty();
+        }
+    }
+}
+
+bool opencog::chunked_line_reader::getline(std::string_view& line)
+{
+    while (_line_pos >= _chunk.size()) {
+        if (not next_chunk(_chunk))
+            return false;
+        _line_pos = 0;
+    }
+    size_t eol = _chunk.find('\n', _line_pos);
+    if (eol == std::string::npos)
+        eol = _chunk.size();
+    line = std::string_view(_chunk).substr(_line_pos, eol - _line_pos);
+    _line_pos = eol + 1;
     return true;
 }
 
@@ -30,9 +30,15 @@
  *
  */
 
+#include <cstddef>
+#include <cstdio>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include <opencog/util/oc_omp.h>
+
 namespace opencog
 {
 /** \addtogroup grp_cogutil
@@ -92,6 +98,201 @@ bool append_file_content(const char* filename, std::string &s);
 /** Load the contents of a textfile \param fname to \param dest. */
 bool load_text_file(const std::string &fname, std::string& dest);
 
+/**
+ * Replace the content of dest by that of the file fname.
+ *
+ * The buffer is sized once from the size of the file and filled with
+ * large read() calls, so the file is copied only once. Files whose
+ * size is unknown (pipes, /proc) are read in blocks.
+ *
+ * @return true if the file was successfully read
+ */
+bool read_file(const std::string& fname, std::string& dest);
+
+/**
+ * Read-only memory mapping of a whole file, unmapped on destruction.
+ *
+ * view() gives the content without copying it, the pages being read
+ * on demand by the kernel. The access hint is passed to madvise() so
+ * that the kernel reads ahead aggressively (sequential) or not at all
+ * (random). Throws an IOException if the file cannot be opened or
+ * mapped. The view is invalidated if the file is truncated meanwhile.
+ */
+class mapped_file
+{
+public:
+    enum access_hint { normal, sequential, random };
+
+    explicit mapped_file(const std::string& fname,
+                         access_hint hint = sequential);
+    ~mapped_file();
+
+    mapped_file(mapped_file&& other);
+    mapped_file& operator=(mapped_file&& other);
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    const char* data() const { return _data; }
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    std::string_view view() const { return std::string_view(_data, _size); }
+
+    //! Change the access hint of the whole mapping
+    void advise(access_hint hint);
+
+    //! Ask the kernel to start reading [offset, offset + length) in
+    //! the background
+    void will_need(size_t offset, size_t length);
+
+private:
+    void unmap();
+
+    const char* _data;
+    size_t _size;
+};
+
+/**
+ * Source of bytes read by chunked_line_reader. Implement it to plug a
+ * decompressor (wrapping zlib, say) in front of a file.
+ */
+class byte_source
+{
+public:
+    virtual ~byte_source() {}
+
+    /**
+     * Read at most size bytes into buf. Return the number of bytes
+     * read, 0 at the end of the input. Throw an IOException on error.
+     */
+    virtual size_t read(char* buf, size_t size) = 0;
+};
+
+//! Uncompressed file
+class file_source : public byte_source
+{
+public:
+    explicit file_source(const std::string& fname);
+    ~file_source();
+    size_t read(char* buf, size_t size);
+private:
+    int _fd;
+};
+
+/**
+ * Output of a shell command, typically a decompression program such
+ * as "gzip -dc file.gz", so that compressed files can be read without
+ * linking against any compression library. At the end of the output,
+ * read throws an IOException if the command failed (a corrupt or
+ * truncated file, a missing program...), rather than leaving the
+ * output silently truncated.
+ */
+class command_source : public byte_source
+{
+public:
+    explicit command_source(const std::string& command);
+    ~command_source();
+    size_t read(char* buf, size_t size);
+private:
+    std::string _command;
+    FILE* _pipe;  // NULL once the command is done
+};
+
+/**
+ * Open fname, decompressing it according to its extension: .gz, .bz2,
+ * .xz and .zst are piped through gzip, bzip2, xz and zstd
+ * respectively, other files are read as is.
+ */
+std::unique_ptr<byte_source> open_byte_source(const std::string& fname);
+
+/**
+ * Read a line-oriented file in large chunks, each made of whole lines
+ * (a line is never split across chunks).
+ *
+ * Lines are delimited by '\n' which is not part of them, as with
+ * std::getline. Besides reading line by line, the chunks can be
+ * handed to several threads, see parallel_parse_lines.
+ */
+class chunked_line_reader
+{
+public:
+    //! Read fname, decompressing it if needed (see open_byte_source)
+    explicit chunked_line_reader(const std::string& fname,
+                                 size_t chunk_size = 1 << 22);
+    chunked_line_reader(std::unique_ptr<byte_source> source,
+                        size_t chunk_size = 1 << 22);
+
+    /**
+     * Replace chunk by the next chunk of about chunk_size bytes (more
+     * if a line is longer). Return false at the end of the input.
+     */
+    bool next_chunk(std::string& chunk);
+
+    /**
+     * Set line to the next line and return true, or return false at
+     * the end of the input. line is only valid until the next call.
+     */
+    bool getline(std::string_view& line);
+
+private:
+    std::unique_ptr<byte_source> _source;
+    size_t _chunk_size;
+    // Beginning of a line read with the previous chunk
+    std::string _carry;
+    bool _eof;
+    // Current chunk and position within it, for getline
+    std::string _chunk;
+    size_t _line_pos;
+};
+
+//! Call f on each line of chunk, as a std::string_view
+template<typename F>
+void for_each_line(std::string_view chunk, F f)
+{
+    size_t pos = 0;
+    while (pos < chunk.size()) {
+        size_t eol = chunk.find('\n', pos);
+        if (eol == std::string_view::npos)
+            eol = chunk.size();
+        f(chunk.substr(pos, eol - pos));
+        pos = eol + 1;
+    }
+}
+
+/**
+ * Apply parse, a function from std::string_view to some type, on all
+ * lines of reader, and write the results to out in the order of the
+ * lines.
+ *
+ * Chunks are read sequentially, by batches of one chunk per thread,
+ * then the chunks of a batch are parsed in parallel (with
+ * parallel_run). parse must be thread safe.
+ */
+template<typename Parse, typename Out>
+Out parallel_parse_lines(chunked_line_reader& reader, Parse parse, Out out)
+{
+    typedef decltype(parse(std::string_view())) result_t;
+    size_t batch = std::max(1U, num_threads());
+    std::vector<std::string> chunks(batch);
+    std::vector<std::vector<result_t>> results(batch);
+    while (true) {
+        size_t n = 0;
+        while (n < batch and reader.next_chunk(chunks[n]))
+            ++n;
+        if (n == 0)
+            break;
+        parallel_run(n, [&](size_t i) {
+                results[i].clear();
+                for_each_line(chunks[i], [&](std::string_view line) {
+                        results[i].push_back(parse(line)); });
+            });
+        for (size_t i = 0; i < n; ++i)
+            out = std::move(results[i].begin(), results[i].end(), out);
+        if (n < batch)
+            break;
+    }
+    return out;
+}
+
 /**
  * Get the file name (including absolute path) of current executing file
  */
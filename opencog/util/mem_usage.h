@@ -0,0 +1,277 @@
+/*
+ * opencog/util/mem_usage.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_MEM_USAGE_H
+#define _OPENCOG_MEM_USAGE_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <opencog/util/metrics.h>
+
+namespace opencog
+{
+/** \addtogroup grp_cogutil
+ *  @{
+ */
+
+/** @name Memory usage
+ *
+ * What the process, the allocator, the memory cgroup and the
+ * components of the process use. All sizes are in bytes. Where a
+ * source is not available (another OS, /proc not mounted, another
+ * allocator) the corresponding fields are 0.
+ */
+///@{
+
+//! Memory of the process, as seen by the kernel
+struct process_memory
+{
+    uint64_t virtual_size;  // all mappings
+    uint64_t rss;           // resident set size
+    uint64_t shared;        // resident pages backed by a file
+
+    // Only filled when asked for details (see get_process_memory)
+    uint64_t pss;           // rss with shared pages divided among sharers
+    uint64_t anonymous;     // resident pages not backed by a file
+    uint64_t swap;          // swapped out
+};
+
+/**
+ * Read the memory of the process from /proc/self/statm and, if
+ * detailed, from /proc/self/smaps_rollup. The latter walks the page
+ * tables of all mappings, so it costs much more (milliseconds for
+ * a large process) and should not be called on hot paths.
+ */
+process_memory get_process_memory(bool detailed = false);
+
+//! Statistics of the malloc heap, from mallinfo2 (glibc 2.33 and
+//! later). They only cover glibc's malloc: when another allocator
+//! (jemalloc, tcmalloc...) is linked in, they are meaningless.
+struct heap_stats
+{
+    bool available;      // whether mallinfo2 could be called
+    uint64_t arena;      // obtained with sbrk
+    uint64_t mmapped;    // obtained with mmap, for large blocks
+    uint64_t in_use;     // allocated and not freed
+    uint64_t free;       // free in the heap, reusable without system call
+    uint64_t releasable; // free at the top of the heap (malloc_trim)
+};
+
+heap_stats get_heap_stats();
+
+//! Memory controller of the cgroup of the process
+struct cgroup_memory
+{
+    uint64_t limit;          // smallest limit of the cgroup and ancestors
+    uint64_t usage;          // charged to the cgroup, page cache included
+    uint64_t inactive_file;  // reclaimable part of the page cache
+};
+
+/**
+ * Read the memory controller of the cgroup of the process, v2 or v1,
+ * taking the smallest limit along the hierarchy. Return false if the
+ * process is not in a memory cgroup or none of the hierarchy has a
+ * limit. The files read can be moved for testing.
+ */
+bool get_cgroup_memory(cgroup_memory& cm,
+                       const std::string& proc_cgroup = "/proc/self/cgroup",
+                       const std::string& cgroup_root = "/sys/fs/cgroup");
+
+//! Memory the process may use: the physical RAM, or the limit of
+//! its cgroup if smaller
+uint64_t get_memory_limit();
+
+//! Memory pressure, as sampled by a memory_pressure_source
+struct memory_pressure_sample
+{
+    double used;      // fraction of get_memory_limit() not free
+    uint64_t rss;     // resident set size of the process
+    double psi_some;  // % of the last 10s some task stalled on memory,
+                      // negative if pressure stall information is
+                      // not available
+    double psi_full;  // same when all tasks stalled
+};
+
+//! Where memory-aware components (see adaptive_cache) get the memory
+//! pressure from. Implementations must be thread safe.
+class memory_pressure_source
+{
+public:
+    virtual ~memory_pressure_source() {}
+    virtual memory_pressure_sample sample() = 0;
+};
+
+/**
+ * Memory pressure of the system, as seen by the process: the free
+ * memory under the physical RAM and cgroup limits, the RSS, and the
+ * pressure stall information of the cgroup (memory.pressure, cgroup
+ * v2) or else of the system (/proc/pressure/memory, Linux 4.20 and
+ * later).
+ *
+ * Reading these costs a few system calls, so samples are cached and
+ * refreshed at most every interval, whatever the number of threads
+ * and components sampling.
+ */
+class system_memory_pressure : public memory_pressure_source
+{
+public:
+    explicit system_memory_pressure(
+        std::chrono::milliseconds interval = std::chrono::milliseconds(100));
+
+    memory_pressure_sample sample() override;
+
+    //! File the pressure stall information is read from, empty if
+    //! not available
+    const std::string& psi_file() const { return _psi_file; }
+
+private:
+    std::chrono::steady_clock::duration _interval;
+    std::string _psi_file;
+    std::mutex _mtx;
+    std::chrono::steady_clock::time_point _last;
+    memory_pressure_sample _sample;
+};
+
+//! Process-wide system_memory_pressure
+memory_pressure_source& memory_pressure();
+
+/**
+ * Bytes allocated by a component of the process, such as a cache.
+ *
+ * Allocations are counted with sharded counters (see metrics.h), so
+ * accounting costs two uncontended atomic additions per allocation
+ * and deallocation. If named, the account is registered in metrics()
+ * as <name>.bytes, <name>.allocations (both live) and
+ * <name>.allocated_bytes (total).
+ */
+class memory_account
+{
+public:
+    explicit memory_account(const std::string& name = "");
+    ~memory_account();
+
+    memory_account(const memory_account&) = delete;
+    memory_account& operator=(const memory_account&) = delete;
+
+    void allocate(size_t bytes)
+    {
+        _allocated.add(bytes);
+        ++_allocations;
+    }
+    void deallocate(size_t bytes)
+    {
+        _freed.add(bytes);
+        ++_deallocations;
+    }
+
+    //! Bytes allocated and not freed yet
+    int64_t bytes() const
+    {
+        return (int64_t)(_allocated.value() - _freed.value());
+    }
+
+    //! Number of blocks allocated and not freed yet
+    int64_t allocations() const
+    {
+        return (int64_t)(_allocations.value() - _deallocations.value());
+    }
+
+    //! Bytes allocated since construction
+    uint64_t allocated_bytes() const { return _allocated.value(); }
+
+    const std::string& name() const { return _name; }
+
+private:
+    counter _allocated;
+    counter _freed;
+    counter _allocations;
+    counter _deallocations;
+    std::string _name;
+};
+
+/**
+ * Standard allocator counting its allocations in a memory_account,
+ * to be given to standard containers, as in
+ *
+ *     memory_account acc("my_component");
+ *     std::vector<int, accounted_allocator<int>> v(acc);
+ *
+ * Only the memory of the container itself is accounted (nodes,
+ * buckets, arrays), not the memory its elements may own. A default
+ * constructed allocator accounts nothing.
+ */
+template<typename T>
+class accounted_allocator
+{
+public:
+    typedef T value_type;
+
+    accounted_allocator() noexcept : _account(nullptr) {}
+    accounted_allocator(memory_account& acc) noexcept : _account(&acc) {}
+    template<typename U>
+    accounted_allocator(const accounted_allocator<U>& a) noexcept
+        : _account(a.account()) {}
+
+    T* allocate(size_t n)
+    {
+        T* p = std::allocator<T>().allocate(n);
+        if (_account)
+            _account->allocate(n * sizeof(T));
+        return p;
+    }
+    void deallocate(T* p, size_t n) noexcept
+    {
+        if (_account)
+            _account->deallocate(n * sizeof(T));
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    memory_account* account() const noexcept { return _account; }
+
+private:
+    memory_account* _account;
+};
+
+template<typename T, typename U>
+bool operator==(const accounted_allocator<T>& a,
+                const accounted_allocator<U>& b)
+{
+    return a.account() == b.account();
+}
+
+template<typename T, typename U>
+bool operator!=(const accounted_allocator<T>& a,
+                const accounted_allocator<U>& b)
+{
+    return not (a == b);
+}
+
+///@}
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_MEM_USAGE_H
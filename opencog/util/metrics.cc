@@ -0,0 +1,268 @@
+/*
+ * opencog/util/metrics.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "exceptions.h"
+#include "metrics.h"
+
+using namespace opencog;
+
+unsigned opencog::next_metric_shard()
+{
+    static std::atomic<unsigned> next(0);
+    return next++ % metric_shards;
+}
+
+uint64_t histogram_snapshot::percentile(double q) const
+{
+    if (count == 0)
+        return 0;
+    uint64_t rank = std::max<uint64_t>(1, std::ceil(q * count)), acc = 0;
+    for (unsigned i = 0; i < counts.size(); ++i) {
+        acc += counts[i];
+        if (acc >= rank)
+            return std::min(std::max(histogram::bucket_upper(i), min), max);
+    }
+    return max;
+}
+
+histogram::~histogram()
+{
+    for (auto& s : _shards)
+        delete s.load();
+}
+
+histogram::shard* histogram::make_shard(unsigned i)
+{
+    shard* s = new shard();
+    shard* expected = nullptr;
+    if (not _shards[i].compare_exchange_strong(expected, s)) {
+        // Another thread of the same shard was first
+        delete s;
+        return expected;
+    }
+    return s;
+}
+
+histogram_snapshot histogram::snapshot() const
+{
+    histogram_snapshot res;
+    res.counts.resize(n_buckets, 0);
+    res.min = UINT64_MAX;
+    for (const auto& ps : _shards) {
+        const shard* s = ps.load(std::memory_order_acquire);
+        if (not s)
+            continue;
+        for (unsigned i = 0; i < n_buckets; ++i)
+            res.counts[i] += s->counts[i].load(std::memory_order_relaxed);
+        res.count += s->count.load(std::memory_order_relaxed);
+        res.sum += s->sum.load(std::memory_order_relaxed);
+        res.min = std::min(res.min, s->min.load(std::memory_order_relaxed));
+        res.max = std::max(res.max, s->max.load(std::memory_order_relaxed));
+    }
+    if (res.count == 0)
+        res.min = 0;
+    return res;
+}
+
+void histogram::reset()
+{
+    for (auto& ps : _shards) {
+        shard* s = ps.load(std::memory_order_acquire);
+        if (not s)
+            continue;
+        for (auto& c : s->counts)
+            c.store(0, std::memory_order_relaxed);
+        s->count.store(0, std::memory_order_relaxed);
+        s->sum.store(0, std::memory_order_relaxed);
+        s->min.store(UINT64_MAX, std::memory_order_relaxed);
+        s->max.store(0, std::memory_order_relaxed);
+    }
+}
+
+MetricsRegistry& opencog::metrics()
+{
+    // Leaked on purpose, see the header
+    static MetricsRegistry* instance = new MetricsRegistry();
+    return *instance;
+}
+
+template<typename M>
+M& MetricsRegistry::get(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    auto it = _metrics.find(name);
+    if (it != _metrics.end()) {
+        if (M** m = std::get_if<M*>(&it->second.metric))
+            return **m;
+        throw InvalidParamException(TRACE_INFO,
+            "MetricsRegistry - %s is a metric of another type",
+            name.c_str());
+    }
+    std::shared_ptr<M> m = std::make_shared<M>();
+    _metrics[name] = entry{m.get(), m};
+    return *m;
+}
+
+counter& MetricsRegistry::get_counter(const std::string& name)
+{
+    return get<counter>(name);
+}
+
+gauge& MetricsRegistry::get_gauge(const std::string& name)
+{
+    return get<gauge>(name);
+}
+
+histogram& MetricsRegistry::get_histogram(const std::string& name)
+{
+    return get<histogram>(name);
+}
+
+void MetricsRegistry::insert(const std::string& name,
+                             std::variant<counter*, gauge*, histogram*,
+                                          reader> m)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    if (not _metrics.emplace(name, entry{std::move(m), nullptr}).second)
+        throw InvalidParamException(TRACE_INFO,
+            "MetricsRegistry - %s is already registered", name.c_str());
+}
+
+void MetricsRegistry::add(const std::string& name, counter& c)
+{
+    insert(name, &c);
+}
+
+void MetricsRegistry::add(const std::string& name, gauge& g)
+{
+    insert(name, &g);
+}
+
+void MetricsRegistry::add(const std::string& name, histogram& h)
+{
+    insert(name, &h);
+}
+
+void MetricsRegistry::add(const std::string& name, reader r)
+{
+    insert(name, std::move(r));
+}
+
+void MetricsRegistry::remove(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    _metrics.erase(name);
+    std::string prefix = name + ".";
+    auto it = _metrics.lower_bound(prefix);
+    while (it != _metrics.end() and it->first.compare(0, prefix.size(), prefix) == 0)
+        it = _metrics.erase(it);
+}
+
+bool MetricsRegistry::contains(const std::string& name) const
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _metrics.find(name) != _metrics.end();
+}
+
+std::string MetricsRegistry::unique_name(const std::string& base)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    unsigned n = ++_instances[base];
+    return n == 1 ? base : base + "#" + std::to_string(n);
+}
+
+static const double dump_percentiles[] = {0.5, 0.9, 0.99, 0.999};
+
+void MetricsRegistry::dump_text(std::ostream& out) const
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    for (const auto& v : _metrics) {
+        out << v.first;
+        const auto& m = v.second.metric;
+        if (auto c = std::get_if<counter*>(&m))
+            out << " " << (*c)->value();
+        else if (auto g = std::get_if<gauge*>(&m))
+            out << " " << (*g)->value();
+        else if (auto r = std::get_if<reader>(&m))
+            out << " " << (*r)();
+        else {
+            histogram_snapshot s = std::get<histogram*>(m)->snapshot();
+            out << " count=" << s.count << " mean=" << s.mean()
+                << " min=" << s.min;
+            for (double q : dump_percentiles)
+                out << " p" << q * 100 << "=" << s.percentile(q);
+            out << " max=" << s.max;
+        }
+        out << "\n";
+    }
+}
+
+// Names are written as they are, apart from quotes and backslashes
+static void write_json_key(std::ostream& out, const std::string& s)
+{
+    out << '"';
+    for (char c : s) {
+        if (c == '"' or c == '\\')
+            out << '\\';
+        out << c;
+    }
+    out << "\":";
+}
+
+// JSON has no infinities nor NaNs
+static void write_json_number(std::ostream& out, double v)
+{
+    if (std::isfinite(v))
+        out << v;
+    else
+        out << "null";
+}
+
+void MetricsRegistry::dump_json(std::ostream& out) const
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    out << "{";
+    bool first = true;
+    for (const auto& v : _metrics) {
+        out << (first ? "" : ",");
+        first = false;
+        write_json_key(out, v.first);
+        const auto& m = v.second.metric;
+        if (auto c = std::get_if<counter*>(&m))
+            out << (*c)->value();
+        else if (auto g = std::get_if<gauge*>(&m))
+            out << (*g)->value();
+        else if (auto r = std::get_if<reader>(&m))
+            write_json_number(out, (*r)());
+        else {
+            histogram_snapshot s = std::get<histogram*>(m)->snapshot();
+            out << "{\"count\":" << s.count << ",\"sum\":" << s.sum
+                << ",\"mean\":" << s.mean() << ",\"min\":" << s.min;
+            for (double q : dump_percentiles)
+                out << ",\"p" << q * 100 << "\":" << s.percentile(q);
+            out << ",\"max\":" << s.max << "}";
+        }
+    }
+    out << "}\n";
+}
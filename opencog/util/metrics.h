@@ -0,0 +1,318 @@
+/*
+ * opencog/util/metrics.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_METRICS_H
+#define _OPENCOG_METRICS_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <opencog/util/octime.h>
+
+namespace opencog
+{
+/** \addtogroup grp_cogutil
+ *  @{
+ */
+
+/** @name Metrics
+ *
+ * Counters, gauges and latency histograms that are cheap enough to
+ * update on hot paths, and a process-wide registry naming them so
+ * that all statistics can be dumped in one go.
+ *
+ * Counters and histograms are sharded: each thread updates the shard
+ * it is assigned (round-robin, when it first touches a metric), and
+ * readers merge the shards. Updates are relaxed atomic additions on a
+ * cache line that is rarely shared, so they do not contend.
+ */
+///@{
+
+//! Number of shards of counters and histograms
+const unsigned metric_shards = 16;
+
+//! Shard assigned to the calling thread
+unsigned next_metric_shard();
+inline unsigned metric_shard()
+{
+    static thread_local unsigned shard = next_metric_shard();
+    return shard;
+}
+
+//! Monotonically increasing count of events
+class counter
+{
+public:
+    counter() {}
+    counter(const counter&) = delete;
+    counter& operator=(const counter&) = delete;
+
+    void add(uint64_t n = 1)
+    {
+        _shards[metric_shard()].value.fetch_add(n, std::memory_order_relaxed);
+    }
+    counter& operator++()
+    {
+        add(1);
+        return *this;
+    }
+
+    uint64_t value() const
+    {
+        uint64_t res = 0;
+        for (const shard& s : _shards)
+            res += s.value.load(std::memory_order_relaxed);
+        return res;
+    }
+    //! Same as value(), for compatibility with std::atomic
+    uint64_t load() const { return value(); }
+
+    void reset()
+    {
+        for (shard& s : _shards)
+            s.value.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    struct alignas(64) shard
+    {
+        std::atomic<uint64_t> value{0};
+    };
+    shard _shards[metric_shards];
+};
+
+//! Value that goes up and down, such as a queue length
+class gauge
+{
+public:
+    gauge() : _value(0) {}
+    gauge(const gauge&) = delete;
+    gauge& operator=(const gauge&) = delete;
+
+    void set(int64_t v) { _value.store(v, std::memory_order_relaxed); }
+    void add(int64_t n) { _value.fetch_add(n, std::memory_order_relaxed); }
+    void sub(int64_t n) { _value.fetch_sub(n, std::memory_order_relaxed); }
+    int64_t value() const { return _value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<int64_t> _value;
+};
+
+//! Merged content of a histogram, see histogram::snapshot()
+struct histogram_snapshot
+{
+    std::vector<uint64_t> counts;  // per bucket
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t min = 0;
+    uint64_t max = 0;
+
+    double mean() const { return count ? (double)sum / count : 0; }
+
+    //! Value below which a fraction q of the recorded values are,
+    //! within the precision of the buckets; 0 if empty
+    uint64_t percentile(double q) const;
+};
+
+/**
+ * Distribution of non-negative integer values, typically latencies in
+ * nanoseconds, in log-linear buckets as in HdrHistogram: each power
+ * of 2 is split into 2^sub_bucket_bits buckets, so that any value is
+ * known within a relative error of 2^-sub_bucket_bits (about 3%),
+ * over the whole range of uint64_t, in 1920 buckets.
+ *
+ * The buckets of a shard are only allocated (15KB) when a thread
+ * assigned to it records its first value.
+ */
+class histogram
+{
+public:
+    static const unsigned sub_bucket_bits = 5;
+    static const unsigned sub_buckets = 1u << sub_bucket_bits;
+    static const unsigned n_buckets = (64 - sub_bucket_bits + 1) * sub_buckets;
+
+    histogram() {}
+    ~histogram();
+    histogram(const histogram&) = delete;
+    histogram& operator=(const histogram&) = delete;
+
+    void record(uint64_t v)
+    {
+        shard* s = _shards[metric_shard()].load(std::memory_order_acquire);
+        if (not s)
+            s = make_shard(metric_shard());
+        s->counts[bucket(v)].fetch_add(1, std::memory_order_relaxed);
+        s->count.fetch_add(1, std::memory_order_relaxed);
+        s->sum.fetch_add(v, std::memory_order_relaxed);
+        uint64_t m = s->min.load(std::memory_order_relaxed);
+        while (v < m and not s->min.compare_exchange_weak(m, v))
+            ;
+        m = s->max.load(std::memory_order_relaxed);
+        while (v > m and not s->max.compare_exchange_weak(m, v))
+            ;
+    }
+
+    //! Merge the shards
+    histogram_snapshot snapshot() const;
+
+    void reset();
+
+    //! Index of the bucket of v
+    static unsigned bucket(uint64_t v)
+    {
+        if (v < sub_buckets)
+            return v;
+        unsigned e = 63 - __builtin_clzll(v);
+        return (e - sub_bucket_bits + 1) * sub_buckets
+            + (unsigned)(v >> (e - sub_bucket_bits)) - sub_buckets;
+    }
+
+    //! Smallest value of bucket i
+    static uint64_t bucket_lower(unsigned i)
+    {
+        if (i < 2 * sub_buckets)
+            return i;
+        unsigned e = i / sub_buckets + sub_bucket_bits - 1;
+        return (uint64_t)(i % sub_buckets + sub_buckets)
+            << (e - sub_bucket_bits);
+    }
+
+    //! Largest value of bucket i
+    static uint64_t bucket_upper(unsigned i)
+    {
+        return i + 1 < n_buckets ? bucket_lower(i + 1) - 1 : UINT64_MAX;
+    }
+
+private:
+    struct shard
+    {
+        std::atomic<uint64_t> counts[n_buckets] = {};
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> sum{0};
+        std::atomic<uint64_t> min{UINT64_MAX};
+        std::atomic<uint64_t> max{0};
+    };
+
+    shard* make_shard(unsigned i);
+
+    std::atomic<shard*> _shards[metric_shards] = {};
+};
+
+//! Record the lifetime of the scope it is declared in, in
+//! nanoseconds, into a histogram
+class scoped_latency
+{
+public:
+    explicit scoped_latency(histogram& h)
+        : _h(h), _start(get_monotonic_nanos()) {}
+    ~scoped_latency() { _h.record(get_monotonic_nanos() - _start); }
+
+private:
+    histogram& _h;
+    uint64_t _start;
+};
+
+/**
+ * Process-wide directory of named metrics.
+ *
+ * Metrics are either owned by the registry, created on first request
+ * by get_counter() and the like and living until the end of the
+ * process, or owned by some component, which adds them in its
+ * constructor and removes them in its destructor. A component can
+ * also publish statistics it already maintains by adding a function
+ * reading them. Names are hierarchical, dot-separated.
+ *
+ * Reading (dump_text, dump_json) and registration are serialized by
+ * a mutex, updating the metrics is not affected by it.
+ */
+class MetricsRegistry
+{
+public:
+    typedef std::function<double()> reader;
+
+    counter& get_counter(const std::string& name);
+    gauge& get_gauge(const std::string& name);
+    histogram& get_histogram(const std::string& name);
+
+    //! Register a metric owned by the caller, which must remove it
+    //! before destroying it. Throw InvalidParamException if the name
+    //! is already taken.
+    void add(const std::string& name, counter&);
+    void add(const std::string& name, gauge&);
+    void add(const std::string& name, histogram&);
+    void add(const std::string& name, reader);
+
+    //! Remove the metric name, and all metrics whose names start with
+    //! name followed by a dot
+    void remove(const std::string& name);
+
+    bool contains(const std::string& name) const;
+
+    //! Return base the first time it is called with base, then base#2,
+    //! base#3 and so on, to name the metrics of each instance of a
+    //! class differently
+    std::string unique_name(const std::string& base);
+
+    //! One line per metric: name followed by its value, or for
+    //! histograms by count, mean, min, percentiles and max
+    void dump_text(std::ostream&) const;
+
+    //! One JSON object, mapping names to values, or for histograms to
+    //! objects of count, sum, mean, min, percentiles and max
+    void dump_json(std::ostream&) const;
+
+private:
+    MetricsRegistry() {}
+    friend MetricsRegistry& metrics();
+
+    template<typename M>
+    M& get(const std::string& name);
+    void insert(const std::string& name,
+                std::variant<counter*, gauge*, histogram*, reader>);
+
+    struct entry
+    {
+        std::variant<counter*, gauge*, histogram*, reader> metric;
+        std::shared_ptr<void> owned;
+    };
+
+    mutable std::mutex _mtx;
+    std::map<std::string, entry> _metrics;
+    std::map<std::string, unsigned> _instances;
+};
+
+//! Return the process-wide metrics registry. It is never destroyed,
+//! so that components may use it until the very end of the process.
+MetricsRegistry& metrics();
+
+///@}
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_METRICS_H
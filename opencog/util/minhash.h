@@ -0,0 +1,257 @@
+/*
+ * opencog/util/minhash.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_MINHASH_H
+#define _OPENCOG_MINHASH_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include <opencog/util/oc_assert.h>
+#include <opencog/util/oc_omp.h>
+#include <opencog/util/sketches.h>
+
+namespace opencog {
+/** \addtogroup grp_cogutil
+ *  @{
+ */
+
+/** @name Approximate Jaccard similarity
+ *
+ * MinHash signatures and a banded locality-sensitive hashing index,
+ * to find the sets that are similar (in the sense of jaccard_index)
+ * to a given set among many, without comparing it to all of them.
+ * Sets are any container of T that jaccard_index accepts, std::set
+ * or bitset_set (with T = size_t) say.
+ */
+///@{
+
+/**
+ * MinHash signature generator (Broder, On the resemblance and
+ * containment of documents, 1997).
+ *
+ * The signature of a set holds, for each of n hash functions, the
+ * minimum hash of its elements. The probability that two sets have
+ * the same minimum for a given hash function is their Jaccard index,
+ * so the fraction of equal components estimates it with a standard
+ * error of at most 1 / (2 sqrt(n)).
+ *
+ * Signatures are only comparable if produced by generators with the
+ * same number of hashes and seed.
+ */
+template<typename T, typename Hash = boost::hash<T>>
+class minhash
+{
+public:
+    typedef std::vector<uint64_t> signature_t;
+
+    minhash(unsigned n_hashes = 128, uint64_t seed = 0)
+        : _seeds(n_hashes)
+    {
+        OC_ASSERT(n_hashes > 0, "minhash: the number of hashes must be "
+                  "positive");
+        for (unsigned i = 0; i < n_hashes; ++i)
+            _seeds[i] = sketch_mix(seed + i);
+    }
+
+    template<typename Set>
+    signature_t signature(const Set& s) const
+    {
+        signature_t sig(_seeds.size(), std::numeric_limits<uint64_t>::max());
+        for (const auto& v : s) {
+            uint64_t h = _hash(v);
+            for (size_t i = 0; i < _seeds.size(); ++i)
+                sig[i] = std::min(sig[i], sketch_mix(h ^ _seeds[i]));
+        }
+        return sig;
+    }
+
+    //! Return the signatures of all sets, computed in parallel
+    template<typename Set>
+    std::vector<signature_t> signatures(const std::vector<Set>& sets) const
+    {
+        std::vector<signature_t> sigs(sets.size());
+        parallel_transform(sets.begin(), sets.end(), sigs.begin(),
+                           [&](const Set& s) { return signature(s); });
+        return sigs;
+    }
+
+    //! Estimate the Jaccard index of the sets of 2 signatures
+    static double similarity(const signature_t& l, const signature_t& r)
+    {
+        OC_ASSERT(l.size() == r.size(),
+                  "minhash: signatures of different sizes %d %d",
+                  l.size(), r.size());
+        size_t eq = 0;
+        for (size_t i = 0; i < l.size(); ++i)
+            eq += l[i] == r[i];
+        return (double)eq / l.size();
+    }
+
+    unsigned n_hashes() const { return _seeds.size(); }
+
+private:
+    std::vector<uint64_t> _seeds;
+    Hash _hash;
+};
+
+/**
+ * Banded LSH index over MinHash signatures.
+ *
+ * Each signature of b * r components is cut into b bands of r rows,
+ * and a set is a candidate for a query if at least one of its bands
+ * is identical to the query's. Two sets of Jaccard index s are then
+ * candidates with probability 1 - (1 - s^r)^b, an S-curve whose
+ * steepest point is around (1 / b)^(1 / r). Candidates are filtered
+ * by their estimated similarity, so that a query costs a few hash
+ * lookups plus the number of candidates, rather than the number of
+ * indexed sets.
+ */
+template<typename T, typename Hash = boost::hash<T>>
+class lsh_index
+{
+public:
+    typedef minhash<T, Hash> minhash_t;
+    typedef typename minhash_t::signature_t signature_t;
+
+    lsh_index(unsigned bands, unsigned rows, uint64_t seed = 0)
+        : _bands(bands), _rows(rows), _minhash(bands * rows, seed),
+          _buckets(bands) {}
+
+    /**
+     * Build an index of n_hashes hashes whose bands and rows are
+     * chosen so that the steepest point of the S-curve is at, or
+     * just below, threshold.
+     */
+    static lsh_index from_threshold(double threshold, unsigned n_hashes = 128,
+                                    uint64_t seed = 0)
+    {
+        OC_ASSERT(0 < threshold and threshold < 1,
+                  "lsh_index: threshold must be in (0, 1)");
+        unsigned best_b = n_hashes, best_r = 1;
+        double best_dist = std::numeric_limits<double>::infinity();
+        for (unsigned r = 1; r <= n_hashes; ++r) {
+            unsigned b = n_hashes / r;
+            double t = std::pow(1.0 / b, 1.0 / r),
+                // Overshooting the threshold loses true positives,
+                // it is penalized more than undershooting.
+                dist = t > threshold ? 2 * (t - threshold) : threshold - t;
+            if (dist < best_dist) {
+                best_dist = dist;
+                best_b = b;
+                best_r = r;
+            }
+        }
+        return lsh_index(best_b, best_r, seed);
+    }
+
+    //! Index s, return its id (the number of sets indexed before it)
+    template<typename Set>
+    size_t insert(const Set& s)
+    {
+        return insert_signature(_minhash.signature(s));
+    }
+
+    //! Index all sets, computing their signatures in parallel
+    template<typename Set>
+    void insert_all(const std::vector<Set>& sets)
+    {
+        for (signature_t& sig : _minhash.signatures(sets))
+            insert_signature(std::move(sig));
+    }
+
+    /**
+     * Return the ids of the indexed sets whose estimated Jaccard index
+     * with s is at least threshold, with their estimates, by
+     * decreasing estimate.
+     */
+    template<typename Set>
+    std::vector<std::pair<size_t, double>> query(const Set& s,
+                                                 double threshold) const
+    {
+        signature_t sig = _minhash.signature(s);
+        std::vector<size_t> candidates;
+        for (unsigned b = 0; b < _bands; ++b) {
+            auto it = _buckets[b].find(band_key(sig, b));
+            if (it != _buckets[b].end())
+                candidates.insert(candidates.end(),
+                                  it->second.begin(), it->second.end());
+        }
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                         candidates.end());
+
+        std::vector<std::pair<size_t, double>> res;
+        for (size_t id : candidates) {
+            double sim = minhash_t::similarity(sig, _signatures[id]);
+            if (sim >= threshold)
+                res.emplace_back(id, sim);
+        }
+        std::stable_sort(res.begin(), res.end(),
+                         [](const std::pair<size_t, double>& l,
+                            const std::pair<size_t, double>& r) {
+                             return l.second > r.second; });
+        return res;
+    }
+
+    const signature_t& signature(size_t id) const { return _signatures[id]; }
+    const minhash_t& get_minhash() const { return _minhash; }
+    size_t size() const { return _signatures.size(); }
+    unsigned bands() const { return _bands; }
+    unsigned rows() const { return _rows; }
+
+private:
+    size_t insert_signature(signature_t sig)
+    {
+        size_t id = _signatures.size();
+        for (unsigned b = 0; b < _bands; ++b)
+            _buckets[b][band_key(sig, b)].push_back(id);
+        _signatures.push_back(std::move(sig));
+        return id;
+    }
+
+    uint64_t band_key(const signature_t& sig, unsigned b) const
+    {
+        uint64_t key = 0;
+        for (unsigned i = b * _rows; i < (b + 1) * _rows; ++i)
+            key = sketch_mix(key ^ sig[i]);
+        return key;
+    }
+
+    unsigned _bands, _rows;
+    minhash_t _minhash;
+    std::vector<signature_t> _signatures;
+    // Per band, map the hash of the band to the ids of the sets
+    std::vector<std::unordered_map<uint64_t, std::vector<size_t>>> _buckets;
+};
+
+///@}
+/** @}*/
+} // ~namespace opencog
+
+#endif // _OPENCOG_MINHASH_H
@@ -20,11 +20,26 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "exceptions.h"
 #include "oc_omp.h"
+#include "thread_placement.h"
 
 namespace opencog {
 
+static std::atomic<unsigned> _num_threads(
+    std::max(1U, std::thread::hardware_concurrency()));
+static std::atomic<unsigned> _minimal_n(1000);
+
 void setting_omp(unsigned num_threads, unsigned min_n) {
+    _num_threads = std::max(1U, num_threads);
+    _minimal_n = min_n;
 #ifdef OC_OMP
     omp_set_dynamic(false);
     omp_set_num_threads(num_threads);
@@ -32,6 +47,9 @@ void setting_omp(unsigned num_threads, unsigned min_n) {
     gps.transform_minimal_n = min_n;
     gps.for_each_minimal_n = min_n;
     gps.replace_minimal_n = min_n;
+    gps.sort_minimal_n = min_n;
+    gps.accumulate_minimal_n = min_n;
+    gps.partial_sum_minimal_n = min_n;
     __gnu_parallel::_Settings::set(gps);
 #endif
 }
@@ -40,14 +58,201 @@ unsigned num_threads() {
 #ifdef OC_OMP
     return omp_get_max_threads();
 #else
-    return 1;
+    return _num_threads;
 #endif
 }
 
+unsigned parallel_minimal_n() {
+    return _minimal_n;
+}
+
 std::pair<unsigned, unsigned> split_jobs(unsigned n_jobs) {
     unsigned n_jobs1 = n_jobs / 2;
     unsigned n_jobs2 = std::max(1U, n_jobs - n_jobs1);
     return {n_jobs1, n_jobs2};
 }
 
+const char* to_string(parallel_backend pb) {
+    switch (pb) {
+    case parallel_backend::GNU_PARALLEL: return "gnu_parallel";
+    case parallel_backend::STD_EXECUTION: return "std_execution";
+    case parallel_backend::THREAD_POOL: return "thread_pool";
+    default: return "serial";
+    }
+}
+
+bool parallel_backend_available(parallel_backend pb) {
+    switch (pb) {
+#ifdef OC_OMP
+    case parallel_backend::GNU_PARALLEL: return true;
+#endif
+#ifdef HAVE_STD_EXECUTION
+    case parallel_backend::STD_EXECUTION: return true;
+#endif
+    case parallel_backend::THREAD_POOL:
+    case parallel_backend::SERIAL: return true;
+    default: return false;
+    }
+}
+
+static std::atomic<parallel_backend> _backend(
+#if defined(OC_OMP)
+    parallel_backend::GNU_PARALLEL
+#elif defined(HAVE_STD_EXECUTION)
+    parallel_backend::STD_EXECUTION
+#else
+    parallel_backend::THREAD_POOL
+#endif
+    );
+
+void set_parallel_backend(parallel_backend pb) {
+    if (not parallel_backend_available(pb))
+        throw InvalidParamException(TRACE_INFO,
+            "Parallel backend %s is not available", to_string(pb));
+    _backend = pb;
+}
+
+parallel_backend get_parallel_backend() {
+    return _backend;
+}
+
+parallel_backend detail::parallel_backend_for(size_t n) {
+    if (n < _minimal_n or n < 2 or num_threads() < 2)
+        return parallel_backend::SERIAL;
+    return _backend;
+}
+
+std::vector<size_t> detail::chunk_bounds(size_t n, size_t n_chunks) {
+    n_chunks = std::max<size_t>(1, std::min(n_chunks, n));
+    std::vector<size_t> bounds(n_chunks + 1);
+    for (size_t i = 0; i <= n_chunks; ++i)
+        bounds[i] = i * n / n_chunks;
+    return bounds;
+}
+
+// Whether the thread is running tasks of parallel_run, so that
+// nested calls run serially rather than wait for the pool
+static thread_local bool _in_parallel_run = false;
+
+/**
+ * Threads of parallel_run. They wait for a run, claim its tasks one
+ * by one from an atomic index, along with the thread running it, and
+ * then the last one done wakes it up.
+ */
+class parallel_pool
+{
+public:
+    ~parallel_pool() { resize(0); }
+
+    //! Run the tasks on n_threads threads, the calling one included.
+    //! Return false if the pool is busy.
+    bool run(size_t n_tasks, const std::function<void(size_t)>& task,
+             unsigned n_threads)
+    {
+        std::unique_lock<std::mutex> run_lock(_run_mtx, std::try_to_lock);
+        if (not run_lock.owns_lock())
+            return false;
+        if (_threads.size() != n_threads - 1)
+            resize(n_threads - 1);
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            _task = &task;
+            _n_tasks = n_tasks;
+            _next = 0;
+            _error = nullptr;
+            _active = _threads.size();
+            ++_generation;
+        }
+        _work_cv.notify_all();
+        _in_parallel_run = true;
+        work();
+        _in_parallel_run = false;
+        std::exception_ptr error;
+        {
+            std::unique_lock<std::mutex> lock(_mtx);
+            _done_cv.wait(lock, [&] { return _active == 0; });
+            std::swap(error, _error);
+        }
+        if (error)
+            std::rethrow_exception(error);
+        return true;
+    }
+
+private:
+    void work()
+    {
+        for (size_t i; (i = _next++) < _n_tasks;) {
+            try {
+                (*_task)(i);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(_mtx);
+                if (not _error)
+                    _error = std::current_exception();
+                _next = _n_tasks;
+            }
+        }
+    }
+
+    void worker_loop(unsigned i, uint64_t generation)
+    {
+        // The calling thread is the first of the run
+        get_thread_placement("parallel_pool").apply(i + 1);
+        _in_parallel_run = true;
+        std::unique_lock<std::mutex> lock(_mtx);
+        while (true) {
+            _work_cv.wait(lock, [&] {
+                    return _stop or _generation != generation; });
+            if (_stop)
+                return;
+            generation = _generation;
+            lock.unlock();
+            work();
+            lock.lock();
+            if (--_active == 0)
+                _done_cv.notify_one();
+        }
+    }
+
+    // Called with _run_mtx locked, so between runs
+    void resize(size_t n)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            _stop = true;
+        }
+        _work_cv.notify_all();
+        for (std::thread& th : _threads)
+            th.join();
+        _threads.clear();
+        _stop = false;
+        for (size_t i = 0; i < n; ++i)
+            _threads.emplace_back(&parallel_pool::worker_loop, this,
+                                  i, _generation);
+    }
+
+    std::mutex _run_mtx;
+    std::mutex _mtx;
+    std::condition_variable _work_cv;
+    std::condition_variable _done_cv;
+    std::vector<std::thread> _threads;
+    bool _stop = false;
+    uint64_t _generation = 0;
+    size_t _active = 0;
+    const std::function<void(size_t)>* _task = nullptr;
+    size_t _n_tasks = 0;
+    std::atomic<size_t> _next{0};
+    std::exception_ptr _error;
+};
+
+void parallel_run(size_t n_tasks, const std::function<void(size_t)>& task) {
+    static parallel_pool pool;
+    unsigned nt = num_threads();
+    if (n_tasks > 1 and nt > 1 and not _in_parallel_run
+        and pool.run(n_tasks, task, nt))
+        return;
+    for (size_t i = 0; i < n_tasks; ++i)
+        task(i);
+}
+
 }
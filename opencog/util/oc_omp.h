@@ -20,10 +20,20 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
-
 #ifndef _OPENCOG_OC_OMP_H
 #define _OPENCOG_OC_OMP_H
 
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <opencog/util/oc_omp_config.h>
+
 /** \addtogroup grp_cogutil
  *  @{
  */
@@ -36,10 +46,35 @@
  * OMP_ALGO::for_each(...) provides the parallel version of
  * std::for_each().
  *
+ * HAVE_PARALLEL_STL and HAVE_STD_EXECUTION come from the generated
+ * oc_omp_config.h, so that they are the same as when cogutil was built.
+ * The code including this file must then be compiled and linked with
+ * OpenMP (-fopenmp) and TBB as cogutil was: linking with the
+ * COGUTIL_LIBRARY of CogUtilConfig.cmake takes care of both. Headers
+ * not including it (algorithm.h...) have no such requirement.
+ *
  * If the cpp define OC_OMP is defined, the parallel versions of the
  * std algorithms are used.   Disabling this define allows code to be
  * compiled with compilers that do not (yet) implement OMP, such as
  * LLVM clang.
+ *
+ * OMP_ALGO is serial without OC_OMP. The parallel_* algorithms below
+ * (parallel_sort, parallel_transform, parallel_for_each,
+ * parallel_reduce, parallel_inclusive_scan) are parallel whatever the
+ * compiler, on one of the following backends:
+ *
+ * - GNU_PARALLEL, the libstdc++ parallel mode (OMP_ALGO with OC_OMP);
+ *
+ * - STD_EXECUTION, the C++17 execution policies (std::execution::par),
+ *   when HAVE_STD_EXECUTION is defined, see FindParallelSTL.cmake;
+ *
+ * - THREAD_POOL, a pool of num_threads() - 1 threads of cogutil,
+ *   always available.
+ *
+ * The first available is used, unless set otherwise with
+ * set_parallel_backend. Ranges of less than parallel_minimal_n()
+ * elements, non random access ranges, or calls with num_threads() = 1
+ * run serially.
  */
 ///@{
 
@@ -53,12 +88,17 @@
 #ifdef OC_OMP
 #include <omp.h>
 #include <parallel/algorithm>
+#include <parallel/numeric>
 #define OMP_ALGO __gnu_parallel
 #else
 #include <algorithm>
 #define OMP_ALGO std
 #endif
 
+#ifdef HAVE_STD_EXECUTION
+#include <execution>
+#endif
+
 namespace opencog {
 
 //! setting the parallel env, such as number of threads, number of
@@ -68,12 +108,246 @@ void setting_omp(unsigned num_threads, unsigned min_n = 50);
 //! returns the number of threads as configured by setting_omp
 unsigned num_threads();
 
+//! returns the minimal number of elements to parallelize, as
+//! configured by setting_omp (1000 by default, as libstdc++)
+unsigned parallel_minimal_n();
+
 //! split the number of jobs in 2. For instance if n_jobs is 3, then it
 //! returns <1, 2>.
 /// This function is convenient for parallalizing
 /// recursive functions
 std::pair<unsigned, unsigned> split_jobs(unsigned n_jobs);
 
+enum class parallel_backend { SERIAL, GNU_PARALLEL, STD_EXECUTION, THREAD_POOL };
+
+const char* to_string(parallel_backend pb);
+
+//! whether the backend is compiled in
+bool parallel_backend_available(parallel_backend pb);
+
+//! Backend of the parallel_* algorithms. Setting a backend that is
+//! not available throws an InvalidParamException.
+void set_parallel_backend(parallel_backend pb);
+parallel_backend get_parallel_backend();
+
+/**
+ * Call task(0), ..., task(n_tasks - 1) on the threads of the pool
+ * and the calling thread, which returns when they are all done. If
+ * a task throws, the remaining ones may not be called and the
+ * exception is rethrown.
+ *
+ * One call runs at a time: a call from another thread while the pool
+ * is busy, or from a task (nested parallelism), runs serially.
+ */
+void parallel_run(size_t n_tasks, const std::function<void(size_t)>& task);
+
+namespace detail {
+
+template<typename It>
+constexpr bool is_random_access()
+{
+    return std::is_base_of<std::random_access_iterator_tag,
+        typename std::iterator_traits<It>::iterator_category>::value;
+}
+
+//! Backend for n elements
+parallel_backend parallel_backend_for(size_t n);
+
+//! Bounds of n_chunks nearly equal chunks of [0, n), with n_chunks
+//! at most n
+std::vector<size_t> chunk_bounds(size_t n, size_t n_chunks);
+
+} //~namespace detail
+
+/**
+ * Parallel std::for_each. f is called concurrently on different
+ * elements, in no particular order.
+ */
+template<typename It, typename F>
+void parallel_for_each(It from, It to, F f)
+{
+    if constexpr (detail::is_random_access<It>()) {
+        size_t n = to - from;
+        switch (detail::parallel_backend_for(n)) {
+#ifdef OC_OMP
+        case parallel_backend::GNU_PARALLEL:
+            __gnu_parallel::for_each(from, to, f);
+            return;
+#endif
+#ifdef HAVE_STD_EXECUTION
+        case parallel_backend::STD_EXECUTION:
+            std::for_each(std::execution::par, from, to, f);
+            return;
+#endif
+        case parallel_backend::THREAD_POOL: {
+            std::vector<size_t> b =
+                detail::chunk_bounds(n, 4 * num_threads());
+            parallel_run(b.size() - 1, [&](size_t i) {
+                    std::for_each(from + b[i], from + b[i+1], f);
+                });
+            return;
+        }
+        default:
+            break;
+        }
+    }
+    std::for_each(from, to, f);
+}
+
+//! Parallel std::transform, out must not overlap [from, to) unless
+//! it is from.
+template<typename It, typename Out, typename F>
+Out parallel_transform(It from, It to, Out out, F f)
+{
+    if constexpr (detail::is_random_access<It>()
+                  and detail::is_random_access<Out>()) {
+        size_t n = to - from;
+        switch (detail::parallel_backend_for(n)) {
+#ifdef OC_OMP
+        case parallel_backend::GNU_PARALLEL:
+            return __gnu_parallel::transform(from, to, out, f);
+#endif
+#ifdef HAVE_STD_EXECUTION
+        case parallel_backend::STD_EXECUTION:
+            return std::transform(std::execution::par, from, to, out, f);
+#endif
+        case parallel_backend::THREAD_POOL: {
+            std::vector<size_t> b =
+                detail::chunk_bounds(n, 4 * num_threads());
+            parallel_run(b.size() - 1, [&](size_t i) {
+                    std::transform(from + b[i], from + b[i+1], out + b[i], f);
+                });
+            return out + n;
+        }
+        default:
+            break;
+        }
+    }
+    return std::transform(from, to, out, f);
+}
+
+//! Parallel std::sort. The sort is not stable.
+template<typename It, typename Cmp = std::less<>>
+void parallel_sort(It from, It to, Cmp cmp = Cmp())
+{
+    size_t n = to - from;
+    switch (detail::parallel_backend_for(n)) {
+#ifdef OC_OMP
+    case parallel_backend::GNU_PARALLEL:
+        __gnu_parallel::sort(from, to, cmp);
+        return;
+#endif
+#ifdef HAVE_STD_EXECUTION
+    case parallel_backend::STD_EXECUTION:
+        std::sort(std::execution::par, from, to, cmp);
+        return;
+#endif
+    case parallel_backend::THREAD_POOL: {
+        // Sort chunks, then merge them pairwise, in rounds
+        std::vector<size_t> b = detail::chunk_bounds(n, num_threads());
+        size_t k = b.size() - 1;
+        parallel_run(k, [&](size_t i) {
+                std::sort(from + b[i], from + b[i+1], cmp);
+            });
+        for (size_t width = 1; width < k; width *= 2) {
+            parallel_run((k + 2 * width - 1) / (2 * width), [&](size_t p) {
+                    size_t lo = 2 * p * width,
+                        mid = std::min(lo + width, k),
+                        hi = std::min(lo + 2 * width, k);
+                    std::inplace_merge(from + b[lo], from + b[mid],
+                                       from + b[hi], cmp);
+                });
+        }
+        return;
+    }
+    default:
+        std::sort(from, to, cmp);
+    }
+}
+
+/**
+ * Parallel std::reduce: init combined with all elements by op, which
+ * must be associative and commutative, as the order of the
+ * combinations is unspecified.
+ */
+template<typename It, typename T, typename Op = std::plus<>>
+T parallel_reduce(It from, It to, T init, Op op = Op())
+{
+    if constexpr (detail::is_random_access<It>()) {
+        size_t n = to - from;
+        switch (detail::parallel_backend_for(n)) {
+#ifdef OC_OMP
+        case parallel_backend::GNU_PARALLEL:
+            return __gnu_parallel::accumulate(from, to, init, op);
+#endif
+#ifdef HAVE_STD_EXECUTION
+        case parallel_backend::STD_EXECUTION:
+            return std::reduce(std::execution::par, from, to, init, op);
+#endif
+        case parallel_backend::THREAD_POOL: {
+            std::vector<size_t> b = detail::chunk_bounds(n, num_threads());
+            std::vector<T> partial(b.size() - 1, init);
+            parallel_run(partial.size(), [&](size_t i) {
+                    partial[i] = std::accumulate(from + b[i] + 1,
+                                                 from + b[i+1],
+                                                 T(from[b[i]]), op);
+                });
+            return std::accumulate(partial.begin(), partial.end(), init, op);
+        }
+        default:
+            break;
+        }
+    }
+    return std::accumulate(from, to, init, op);
+}
+
+/**
+ * Parallel std::inclusive_scan: out[i] = from[0] op ... op from[i],
+ * op being associative. out may be from.
+ */
+template<typename It, typename Out, typename Op = std::plus<>>
+Out parallel_inclusive_scan(It from, It to, Out out, Op op = Op())
+{
+    if constexpr (detail::is_random_access<It>()
+                  and detail::is_random_access<Out>()) {
+        size_t n = to - from;
+        switch (detail::parallel_backend_for(n)) {
+#ifdef OC_OMP
+        case parallel_backend::GNU_PARALLEL:
+            return __gnu_parallel::partial_sum(from, to, out, op);
+#endif
+#ifdef HAVE_STD_EXECUTION
+        case parallel_backend::STD_EXECUTION:
+            return std::inclusive_scan(std::execution::par,
+                                       from, to, out, op);
+#endif
+        case parallel_backend::THREAD_POOL: {
+            // Scan the chunks, then add to each the total of the
+            // chunks before it
+            std::vector<size_t> b = detail::chunk_bounds(n, num_threads());
+            size_t k = b.size() - 1;
+            parallel_run(k, [&](size_t i) {
+                    std::inclusive_scan(from + b[i], from + b[i+1],
+                                        out + b[i], op);
+                });
+            typedef typename std::iterator_traits<It>::value_type V;
+            std::vector<V> offsets;
+            for (size_t i = 1; i < k; ++i)
+                offsets.push_back(i == 1 ? V(out[b[1] - 1])
+                                  : op(offsets.back(), out[b[i] - 1]));
+            parallel_run(k - 1, [&](size_t i) {
+                    for (size_t j = b[i+1]; j < b[i+2]; ++j)
+                        out[j] = op(offsets[i], out[j]);
+                });
+            return out + n;
+        }
+        default:
+            break;
+        }
+    }
+    return std::inclusive_scan(from, to, out, op);
+}
+
 } // ~namespace opencog
 
 ///@}
@@ -0,0 +1,385 @@
+/*
+ * opencog/util/online_stats.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_ONLINE_STATS_H
+#define _OPENCOG_ONLINE_STATS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <opencog/util/Counter.h>
+#include <opencog/util/oc_assert.h>
+
+namespace opencog {
+/** \addtogroup grp_cogutil
+ *  @{
+ */
+
+/** @name Online statistics
+ * Single-pass estimators over unbounded streams. None of them stores
+ * the stream, and all of them can be filled per thread and merged
+ * afterwards.
+ */
+///@{
+
+/**
+ * Count, mean, variance, min and max of a stream, using Welford's
+ * numerically stable update. merge() uses the pairwise formula of
+ * Chan et al.
+ */
+template<typename FloatT = double>
+class online_moments
+{
+public:
+    online_moments()
+        : _n(0), _mean(0), _m2(0),
+          _min(std::numeric_limits<FloatT>::infinity()),
+          _max(-std::numeric_limits<FloatT>::infinity()) {}
+
+    void add(FloatT x)
+    {
+        ++_n;
+        FloatT delta = x - _mean;
+        _mean += delta / _n;
+        _m2 += delta * (x - _mean);
+        _min = std::min(_min, x);
+        _max = std::max(_max, x);
+    }
+
+    online_moments& merge(const online_moments& other)
+    {
+        if (other._n == 0)
+            return *this;
+        if (_n == 0)
+            return *this = other;
+        uint64_t n = _n + other._n;
+        FloatT delta = other._mean - _mean;
+        _mean += delta * other._n / n;
+        _m2 += other._m2 + delta * delta * ((FloatT)_n * other._n / n);
+        _n = n;
+        _min = std::min(_min, other._min);
+        _max = std::max(_max, other._max);
+        return *this;
+    }
+
+    uint64_t count() const { return _n; }
+    FloatT mean() const { return _mean; }
+    FloatT min() const { return _min; }
+    FloatT max() const { return _max; }
+
+    //! Population variance, that is sum (x - mean)^2 / n
+    FloatT variance() const
+    {
+        return _n > 0 ? _m2 / _n : 0;
+    }
+
+    //! Unbiased sample variance, that is sum (x - mean)^2 / (n - 1)
+    FloatT sample_variance() const
+    {
+        return _n > 1 ? _m2 / (_n - 1) : 0;
+    }
+
+    FloatT stddev() const { return std::sqrt(variance()); }
+
+private:
+    uint64_t _n;
+    FloatT _mean, _m2, _min, _max;
+};
+
+/**
+ * Exponentially weighted moving average. Each new value x updates the
+ * average with
+ *
+ * avg = decay * x + (1 - decay) * avg
+ *
+ * like recent_val, except that the average is bias corrected, that is
+ * it is not pulled toward the initial value 0 at the beginning of the
+ * stream. It can also be built from a half-life, the number of
+ * updates after which a value has lost half its weight.
+ *
+ * merge() combines two streams as if they were interleaved, each
+ * value keeping the weight it had in its own stream.
+ */
+template<typename FloatT = double>
+class ewma
+{
+public:
+    ewma(FloatT decay = 0.5) : _decay(decay), _sum(0), _weight(0)
+    {
+        OC_ASSERT(0 < decay and decay <= 1,
+                  "ewma: decay must be in (0, 1]");
+    }
+
+    static ewma from_half_life(FloatT half_life)
+    {
+        OC_ASSERT(half_life > 0, "ewma: half-life must be positive");
+        return ewma(1 - std::exp2(-1 / half_life));
+    }
+
+    void add(FloatT x)
+    {
+        _sum = _decay * x + (1 - _decay) * _sum;
+        _weight = _decay + (1 - _decay) * _weight;
+    }
+
+    ewma& merge(const ewma& other)
+    {
+        OC_ASSERT(_decay == other._decay,
+                  "ewma: cannot merge averages of different decays");
+        _sum += other._sum;
+        _weight += other._weight;
+        return *this;
+    }
+
+    //! Return the bias corrected average, 0 if nothing was added
+    FloatT value() const
+    {
+        return _weight > 0 ? _sum / _weight : 0;
+    }
+
+    FloatT decay() const { return _decay; }
+
+private:
+    FloatT _decay, _sum, _weight;
+};
+
+/**
+ * Entropy (in bits) of the empirical distribution of a stream of
+ * keys. Using
+ *
+ * H = log2(N) - (1/N) Sum_i c_i log2(c_i)
+ *
+ * where c_i is the count of key i and N the total count, the sum is
+ * maintained incrementally so that entropy() is O(1) and add() is the
+ * cost of a Counter update. Only the counts of the distinct keys are
+ * stored.
+ */
+template<typename T, typename CMP = std::less<T>>
+class online_entropy
+{
+public:
+    typedef Counter<T, uint64_t, CMP> counter_t;
+
+    online_entropy() : _total(0), _sum_clogc(0) {}
+
+    void add(const T& key, uint64_t c = 1)
+    {
+        uint64_t& cnt = _counter[key];
+        _sum_clogc -= clogc(cnt);
+        cnt += c;
+        _sum_clogc += clogc(cnt);
+        _total += c;
+    }
+
+    online_entropy& merge(const online_entropy& other)
+    {
+        for (const auto& v : other._counter)
+            add(v.first, v.second);
+        return *this;
+    }
+
+    double entropy() const
+    {
+        if (_total == 0)
+            return 0;
+        return std::max(0.0, std::log2((double)_total) - _sum_clogc / _total);
+    }
+
+    uint64_t total_count() const { return _total; }
+    const counter_t& counter() const { return _counter; }
+
+private:
+    static double clogc(uint64_t c)
+    {
+        return c > 0 ? c * std::log2((double)c) : 0;
+    }
+
+    counter_t _counter;
+    uint64_t _total;
+    double _sum_clogc;
+};
+
+/**
+ * Approximate quantiles using the KLL sketch (Karnin, Lang & Liberty,
+ * Optimal Quantile Approximation in Streams, 2016).
+ *
+ * Values are kept in a hierarchy of compactors; an item at level h
+ * stands for 2^h values of the stream. When a level is full it is
+ * sorted and every other item is promoted to the next level. With
+ * parameter k, the memory is O(k) and the rank error is about
+ * 1.7 / k with high probability (around 1% for the default k = 200).
+ * The minimum and maximum are tracked exactly.
+ */
+template<typename FloatT = double>
+class kll_quantiles
+{
+public:
+    kll_quantiles(unsigned k = 200, uint64_t seed = 0)
+        : _k(k), _n(0), _size(0), _max_size(0), _rng_state(seed),
+          _min(std::numeric_limits<FloatT>::infinity()),
+          _max(-std::numeric_limits<FloatT>::infinity())
+    {
+        OC_ASSERT(k >= 8, "kll_quantiles: k must be at least 8");
+        grow();
+    }
+
+    void add(FloatT x)
+    {
+        _compactors[0].push_back(x);
+        ++_n;
+        ++_size;
+        _min = std::min(_min, x);
+        _max = std::max(_max, x);
+        if (_size >= _max_size)
+            compress();
+    }
+
+    kll_quantiles& merge(const kll_quantiles& other)
+    {
+        while (_compactors.size() < other._compactors.size())
+            grow();
+        for (size_t h = 0; h < other._compactors.size(); ++h)
+            _compactors[h].insert(_compactors[h].end(),
+                                  other._compactors[h].begin(),
+                                  other._compactors[h].end());
+        _n += other._n;
+        _size += other._size;
+        _min = std::min(_min, other._min);
+        _max = std::max(_max, other._max);
+        while (_size >= _max_size)
+            compress();
+        return *this;
+    }
+
+    //! Return the approximate q-quantile, q in [0, 1]
+    FloatT quantile(double q) const
+    {
+        OC_ASSERT(_n > 0, "kll_quantiles: quantile of an empty stream");
+        if (q <= 0) return _min;
+        if (q >= 1) return _max;
+        std::vector<std::pair<FloatT, uint64_t>> items = weighted_items();
+        double target = q * _n;
+        uint64_t cum = 0;
+        for (const auto& v : items) {
+            cum += v.second;
+            if (cum >= target)
+                return v.first;
+        }
+        return _max;
+    }
+
+    //! Return the approximate fraction of the stream that is <= x
+    double rank(FloatT x) const
+    {
+        if (_n == 0)
+            return 0;
+        uint64_t w = 0;
+        for (size_t h = 0; h < _compactors.size(); ++h)
+            for (FloatT v : _compactors[h])
+                if (v <= x)
+                    w += uint64_t(1) << h;
+        return (double)w / _n;
+    }
+
+    uint64_t count() const { return _n; }
+    FloatT min() const { return _min; }
+    FloatT max() const { return _max; }
+
+    //! Return the number of values currently retained
+    size_t retained() const { return _size; }
+
+private:
+    size_t capacity(size_t h) const
+    {
+        size_t depth = _compactors.size() - h - 1;
+        return std::ceil(std::pow(2.0 / 3.0, depth) * _k) + 1;
+    }
+
+    void grow()
+    {
+        _compactors.emplace_back();
+        _max_size = 0;
+        for (size_t h = 0; h < _compactors.size(); ++h)
+            _max_size += capacity(h);
+    }
+
+    // Compact the lowest full level
+    void compress()
+    {
+        for (size_t h = 0; h < _compactors.size(); ++h) {
+            if (_compactors[h].size() < capacity(h))
+                continue;
+            if (h + 1 == _compactors.size())
+                grow();
+            std::vector<FloatT>& c = _compactors[h];
+            std::sort(c.begin(), c.end());
+            // Keep the last item if the size is odd
+            FloatT last = c.back();
+            bool odd = c.size() % 2;
+            size_t m = c.size() - odd;
+            for (size_t i = coin(); i < m; i += 2)
+                _compactors[h + 1].push_back(c[i]);
+            c.clear();
+            if (odd)
+                c.push_back(last);
+            _size -= m / 2;
+            break;
+        }
+    }
+
+    std::vector<std::pair<FloatT, uint64_t>> weighted_items() const
+    {
+        std::vector<std::pair<FloatT, uint64_t>> items;
+        items.reserve(_size);
+        for (size_t h = 0; h < _compactors.size(); ++h)
+            for (FloatT v : _compactors[h])
+                items.emplace_back(v, uint64_t(1) << h);
+        std::sort(items.begin(), items.end());
+        return items;
+    }
+
+    // Random bit from a splitmix64 generator; the sketch only needs
+    // a fair coin and must be cheap to copy.
+    unsigned coin()
+    {
+        uint64_t z = (_rng_state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return (z ^ (z >> 31)) & 1;
+    }
+
+    unsigned _k;
+    uint64_t _n;
+    size_t _size, _max_size;
+    uint64_t _rng_state;
+    FloatT _min, _max;
+    std::vector<std::vector<FloatT>> _compactors;
+};
+
+///@}
+/** @}*/
+} // ~namespace opencog
+
+#endif // _OPENCOG_ONLINE_STATS_H
@@ -0,0 +1,162 @@
+/*
+ * opencog/util/parallel_algorithm.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_PARALLEL_ALGORITHM_H
+#define _OPENCOG_PARALLEL_ALGORITHM_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <opencog/util/algorithm.h>
+#include <opencog/util/oc_assert.h>
+#include <opencog/util/oc_omp.h>
+
+/**
+ * Parallel counterparts of some algorithms of algorithm.h, kept apart
+ * so that algorithm.h does not depend on oc_omp.h and its link
+ * requirements.
+ */
+
+namespace opencog
+{
+/** \addtogroup grp_cogutil
+ *  @{
+ */
+
+//! Split [0, total) into at most n_chunks contiguous ranges of
+//! nearly equal sizes
+inline std::vector<std::pair<uint64_t, uint64_t>>
+split_index_range(uint64_t total, uint64_t n_chunks)
+{
+	std::vector<std::pair<uint64_t, uint64_t>> chunks;
+	n_chunks = std::max<uint64_t>(1, std::min(n_chunks, total));
+	uint64_t begin = 0;
+	for (uint64_t i = 0; i < n_chunks; ++i) {
+		uint64_t end = begin + total / n_chunks + (i < total % n_chunks);
+		chunks.emplace_back(begin, end);
+		begin = end;
+	}
+	return chunks;
+}
+
+//! Split [0, total) into chunks to be handed to parallel_run, 4 per
+//! thread, or a single one (thus processed serially) if total is less
+//! than parallel_minimal_n()
+inline std::vector<std::pair<uint64_t, uint64_t>>
+split_parallel_range(uint64_t total)
+{
+	return split_index_range(total, total < parallel_minimal_n() ?
+	                         1 : 4 * num_threads());
+}
+
+/**
+ * Parallel versions of for_each_subset and for_each_product. The
+ * index space (the ranks of the subsets or tuples) is split into
+ * chunks handed to parallel_run. Each chunk unranks its first
+ * element and then enumerates sequentially, so f is called in
+ * parallel with a per-chunk buffer; it must be thread safe. The order
+ * of the calls is unspecified.
+ */
+template<typename C, typename F>
+void parallel_for_each_subset(const C& c, size_t k, F f)
+{
+	std::vector<typename C::value_type> elems(c.begin(), c.end());
+	size_t n = elems.size();
+	if (k > n) return;
+	uint64_t total = binomial(n, k);
+	std::vector<std::pair<uint64_t, uint64_t>> chunks =
+		split_parallel_range(total);
+	parallel_run(chunks.size(), [&](size_t c) {
+			const std::pair<uint64_t, uint64_t>& chunk = chunks[c];
+			// Unrank the first combination of the chunk
+			std::vector<size_t> idx(k);
+			uint64_t r = chunk.first;
+			size_t x = 0;
+			for (size_t i = 0; i < k; ++i) {
+				while (true) {
+					uint64_t cnt = binomial(n - x - 1, k - i - 1);
+					if (r < cnt) break;
+					r -= cnt;
+					++x;
+				}
+				idx[i] = x++;
+			}
+			std::vector<typename C::value_type> subset(k);
+			for (uint64_t rank = chunk.first; rank < chunk.second; ++rank) {
+				for (size_t i = 0; i < k; ++i)
+					subset[i] = elems[idx[i]];
+				f(subset);
+				size_t i = k;
+				while (i > 0 and idx[i-1] == n - k + i - 1)
+					--i;
+				if (i == 0) break;
+				++idx[i-1];
+				for (size_t j = i; j < k; ++j)
+					idx[j] = idx[j-1] + 1;
+			}
+		});
+}
+
+template<typename C, typename F>
+void parallel_for_each_product(const C& c, size_t nfold, F f)
+{
+	std::vector<typename C::value_type> elems(c.begin(), c.end());
+	size_t n = elems.size();
+	if (n == 0) {
+		if (nfold == 0) f(elems);
+		return;
+	}
+	uint64_t total = 1;
+	for (size_t i = 0; i < nfold; ++i)
+		OC_ASSERT(not __builtin_mul_overflow(total, (uint64_t)n, &total),
+		          "parallel_for_each_product: overflow");
+	std::vector<std::pair<uint64_t, uint64_t>> chunks =
+		split_parallel_range(total);
+	parallel_run(chunks.size(), [&](size_t c) {
+			const std::pair<uint64_t, uint64_t>& chunk = chunks[c];
+			// Unrank the first tuple of the chunk, in base n
+			std::vector<size_t> odometer(nfold);
+			std::vector<typename C::value_type> tuple(nfold, elems[0]);
+			uint64_t r = chunk.first;
+			for (size_t i = nfold; i > 0; --i) {
+				odometer[i-1] = r % n;
+				tuple[i-1] = elems[odometer[i-1]];
+				r /= n;
+			}
+			for (uint64_t rank = chunk.first; rank < chunk.second; ++rank) {
+				f(tuple);
+				size_t i = nfold;
+				while (i > 0 and odometer[i-1] + 1 == n) {
+					odometer[i-1] = 0;
+					tuple[i-1] = elems[0];
+					--i;
+				}
+				if (i == 0) break;
+				tuple[i-1] = elems[++odometer[i-1]];
+			}
+		});
+}
+
+/** @}*/
+} //~namespace opencog
+
+#endif // _OPENCOG_PARALLEL_ALGORITHM_H
@@ -0,0 +1,199 @@
+/*
+ * opencog/util/perf_counters.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "perf_counters.h"
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace opencog;
+
+const char* perf_counts::name(event e)
+{
+    static const char* names[N_EVENTS] = {
+        "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses"
+    };
+    return names[e];
+}
+
+double perf_counts::ipc() const
+{
+    if (not has(CYCLES) or not has(INSTRUCTIONS) or value[CYCLES] == 0)
+        return 0;
+    return (double)value[INSTRUCTIONS] / value[CYCLES];
+}
+
+perf_counts perf_counts::operator-(const perf_counts& c) const
+{
+    perf_counts res;
+    res.mask = mask & c.mask;
+    for (unsigned e = 0; e < N_EVENTS; ++e)
+        if (res.mask & (1u << e))
+            // Scaled values of multiplexed counters may go backward
+            res.value[e] = value[e] > c.value[e] ? value[e] - c.value[e] : 0;
+    return res;
+}
+
+perf_counts& perf_counts::operator+=(const perf_counts& c)
+{
+    if (empty()) {
+        *this = c;
+        return *this;
+    }
+    mask &= c.mask;
+    for (unsigned e = 0; e < N_EVENTS; ++e)
+        value[e] = mask & (1u << e) ? value[e] + c.value[e] : 0;
+    return *this;
+}
+
+std::ostream& opencog::operator<<(std::ostream& out, const perf_counts& c)
+{
+    const char* sep = "";
+    for (unsigned e = 0; e < perf_counts::N_EVENTS; ++e) {
+        perf_counts::event ev = (perf_counts::event)e;
+        if (c.has(ev)) {
+            out << sep << perf_counts::name(ev) << "=" << c[ev];
+            sep = " ";
+        }
+    }
+    return out;
+}
+
+#ifdef __linux__
+
+// Type and config of each event, in the order of perf_counts::event
+static void event_attr(perf_counts::event e, perf_event_attr& attr)
+{
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    switch (e) {
+    case perf_counts::CYCLES:
+        attr.config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+    case perf_counts::INSTRUCTIONS:
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+    case perf_counts::L1D_MISSES:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_L1D
+            | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+            | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        break;
+    case perf_counts::LLC_MISSES:
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        break;
+    default:
+        attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+    }
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED
+        | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+}
+
+perf_counters::perf_counters(unsigned events) : _n(0), _mask(0)
+{
+    int leader = -1;
+    for (unsigned e = 0; e < perf_counts::N_EVENTS; ++e) {
+        if (not (events & (1u << e)))
+            continue;
+        perf_event_attr attr;
+        event_attr((perf_counts::event)e, attr);
+        // The leader starts disabled, so that the whole group is
+        // enabled at once below
+        attr.disabled = leader < 0;
+        int fd = syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0);
+        if (fd < 0)
+            continue;
+        if (leader < 0)
+            leader = fd;
+        _fds[_n] = fd;
+        _order[_n++] = (perf_counts::event)e;
+        _mask |= 1u << e;
+    }
+    if (leader >= 0)
+        ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+perf_counters::~perf_counters()
+{
+    // Close the members before the leader
+    while (_n > 0)
+        close(_fds[--_n]);
+}
+
+perf_counts perf_counters::read() const
+{
+    perf_counts res;
+    if (_n == 0)
+        return res;
+
+    // nr, time_enabled, time_running, then one value per event
+    uint64_t buf[3 + perf_counts::N_EVENTS];
+    ssize_t size = ::read(_fds[0], buf, sizeof(buf));
+    if (size < (ssize_t)(3 * sizeof(uint64_t)) or buf[0] != _n)
+        return res;
+    uint64_t enabled = buf[1], running = buf[2];
+    // The group could not be scheduled yet
+    if (running == 0)
+        return res;
+
+    for (unsigned i = 0; i < _n; ++i) {
+        uint64_t v = buf[3 + i];
+        if (running < enabled)
+            v = (uint64_t)((double)v * enabled / running);
+        res.value[_order[i]] = v;
+    }
+    res.mask = _mask;
+    return res;
+}
+
+#else // __linux__
+
+perf_counters::perf_counters(unsigned) : _n(0), _mask(0) {}
+
+perf_counters::~perf_counters() {}
+
+perf_counts perf_counters::read() const
+{
+    return perf_counts();
+}
+
+#endif // __linux__
+
+bool perf_counters::supported()
+{
+    static const bool res = perf_counters().available();
+    return res;
+}
+
+perf_counters& opencog::local_perf_counters()
+{
+    static thread_local perf_counters pc;
+    return pc;
+}
@@ -0,0 +1,165 @@
+/*
+ * opencog/util/perf_counters.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_PERF_COUNTERS_H
+#define _OPENCOG_PERF_COUNTERS_H
+
+#include <cstdint>
+#include <ostream>
+
+namespace opencog
+{
+/** \addtogroup grp_cogutil
+ *  @{
+ */
+
+/**
+ * Values of the hardware performance counters. Only the events whose
+ * bit is set in mask have been counted; the others are 0.
+ */
+struct perf_counts
+{
+    enum event {
+        CYCLES,
+        INSTRUCTIONS,
+        L1D_MISSES,     // L1 data cache read misses
+        LLC_MISSES,     // last level cache misses
+        BRANCH_MISSES,
+        N_EVENTS
+    };
+
+    static const unsigned ALL = (1u << N_EVENTS) - 1;
+
+    //! Short name of an event, as used in reports ("cycles", ...)
+    static const char* name(event e);
+
+    perf_counts() : mask(0), value{} {}
+
+    bool has(event e) const { return mask & (1u << e); }
+    bool empty() const { return mask == 0; }
+    uint64_t operator[](event e) const { return value[e]; }
+
+    //! Instructions per cycle, 0 if either was not counted
+    double ipc() const;
+
+    //! Counts between an earlier reading c and this one. Only the
+    //! events counted in both are kept.
+    perf_counts operator-(const perf_counts& c) const;
+
+    //! Accumulate c, keeping only the events counted in both (unless
+    //! this one is still empty)
+    perf_counts& operator+=(const perf_counts& c);
+
+    unsigned mask;
+    uint64_t value[N_EVENTS];
+};
+
+//! Print the counted events, as in "cycles=1200 instructions=3400"
+std::ostream& operator<<(std::ostream& out, const perf_counts& c);
+
+/**
+ * Hardware performance counters of the calling thread, opened with
+ * perf_event_open(2) for user space only.
+ *
+ * The counters run from construction on, and read() returns their
+ * current values, so that the cost of a region is the difference of
+ * two readings (see perf_scope). They are opened as a single group,
+ * read by a single system call, and scaled if the kernel had to
+ * multiplex them with other users of the counters.
+ *
+ * Events that cannot be opened (not supported by the CPU or the
+ * hypervisor, perf_event_paranoid too restrictive, no perf support in
+ * the kernel, or a platform other than Linux) are simply left out of
+ * the mask: the counters never throw, and when none is available
+ * read() returns empty counts.
+ *
+ * The counters only count the thread that created them, so an
+ * instance should not be shared between threads; use
+ * local_perf_counters() to get the instance of the calling thread.
+ */
+class perf_counters
+{
+public:
+    //! Open the events of the mask (a combination of 1 << event)
+    explicit perf_counters(unsigned events = perf_counts::ALL);
+    ~perf_counters();
+
+    perf_counters(const perf_counters&) = delete;
+    perf_counters& operator=(const perf_counters&) = delete;
+
+    //! Mask of the events that could be opened
+    unsigned events() const { return _mask; }
+    bool available() const { return _mask != 0; }
+
+    //! Current values since construction
+    perf_counts read() const;
+
+    //! Whether any hardware event can be counted in this process,
+    //! checked once
+    static bool supported();
+
+private:
+    int _fds[perf_counts::N_EVENTS];
+    perf_counts::event _order[perf_counts::N_EVENTS]; // events by group index
+    unsigned _n;       // number of opened events
+    unsigned _mask;
+};
+
+//! Counters of all events for the calling thread, opened on first use
+perf_counters& local_perf_counters();
+
+/**
+ * Add the counts of the enclosing scope, in the calling thread, to
+ * the given perf_counts. Costs two reads of the counters, or nothing
+ * measurable if they are not available.
+ *
+ *     perf_counts pc;
+ *     {
+ *         perf_scope ps(pc);
+ *         ...
+ *     }
+ *     std::cout << pc << std::endl;
+ */
+class perf_scope
+{
+public:
+    explicit perf_scope(perf_counts& dest,
+                        perf_counters& pc = local_perf_counters())
+        : _dest(dest), _pc(pc), _start(pc.read()) {}
+    ~perf_scope()
+    {
+        if (not _start.empty())
+            _dest += _pc.read() - _start;
+    }
+
+    perf_scope(const perf_scope&) = delete;
+    perf_scope& operator=(const perf_scope&) = delete;
+
+private:
+    perf_counts& _dest;
+    perf_counters& _pc;
+    perf_counts _start;
+};
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_PERF_COUNTERS_H
@@ -163,28 +163,28 @@ unsigned long long atoll(const char *str)
 
 // ==========================================================
 
+#include <algorithm>
 #include <stdlib.h>
-#include <unistd.h>   // for sbrk(), sysconf()
+#include <unistd.h>   // for sysconf()
 
-// Return memory usage per sbrk system call.
-size_t opencog::getMemUsage()
-{
-    static void *old_sbrk = 0;
-    void *p = sbrk(0);
-    if (old_sbrk == 0 || old_sbrk > p)
-    {
-        old_sbrk = p;
-        return 0;
-    }
-    size_t diff = (size_t)p - (size_t)old_sbrk;
-    return diff;
-}
+#include "mem_usage.h"
 
 #ifdef __APPLE__
+#include <mach/mach.h>
 #include <sys/sysctl.h>
 #include <sys/types.h>
 #include <pthread.h>
 
+size_t opencog::getMemUsage()
+{
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                  (task_info_t)&info, &count) != KERN_SUCCESS)
+        return 0;
+    return info.resident_size;
+}
+
 uint64_t opencog::getTotalRAM()
 {
    int mib[2];
@@ -213,6 +213,18 @@ void opencog::set_thread_name(const char* name)
 // If not Apple, then Linux.
 #include <sys/sysinfo.h>
 #include <sys/prctl.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+// sbrk(0) used to be sampled here, but it misses all blocks obtained
+// with mmap (the large ones, for glibc's malloc) and means nothing
+// with other allocators, so read the resident set size instead.
+size_t opencog::getMemUsage()
+{
+    return get_process_memory().rss;
+}
 
 uint64_t opencog::getTotalRAM()
 {
@@ -220,10 +232,41 @@ uint64_t opencog::getTotalRAM()
     return getpagesize() * sysconf(_SC_PHYS_PAGES);
 }
 
+// MemAvailable of /proc/meminfo, the estimate of the kernel of the
+// memory available without swapping, 0 if there is none (before Linux
+// 3.14)
+static uint64_t mem_available()
+{
+    std::ifstream meminfo("/proc/meminfo");
+    std::string line;
+    while (std::getline(meminfo, line)) {
+        char key[32];
+        unsigned long long kb;
+        if (sscanf(line.c_str(), "%31s %llu", key, &kb) == 2
+            and strcmp(key, "MemAvailable:") == 0)
+            return kb * 1024;
+    }
+    return 0;
+}
+
 uint64_t opencog::getFreeRAM()
 {
-    // return getpagesize() * get_avphys_pages();
-    return getpagesize() * sysconf(_SC_AVPHYS_PAGES);
+    // The reclaimable page cache is not counted as used, since the
+    // kernel drops it when memory runs low: MemAvailable counts it as
+    // available, unlike MemFree (_SC_AVPHYS_PAGES), only used as a
+    // fallback. Likewise for the limit of the cgroup, the inactive
+    // file pages are not counted as used.
+    uint64_t free_ram = mem_available();
+    if (free_ram == 0)
+        free_ram = getpagesize() * sysconf(_SC_AVPHYS_PAGES);
+
+    cgroup_memory cm;
+    if (get_cgroup_memory(cm)) {
+        uint64_t used = cm.usage - std::min(cm.usage, cm.inactive_file);
+        uint64_t left = cm.limit > used ? cm.limit - used : 0;
+        free_ram = std::min(free_ram, left);
+    }
+    return free_ram;
 }
 
 void opencog::set_thread_name(const char* name)
@@ -67,13 +67,16 @@ namespace opencog
  *  @{
  */
 
-//! Return the total amount of heap allocated (according to sbrk, on unix).
+//! Return the resident set size of the process, in bytes. See
+//! mem_usage.h for more details on the memory of the process.
 size_t getMemUsage();
 
 //! Return the total number of bytes of physical RAM installed.
 uint64_t getTotalRAM();
 
-//! Return the total number of free bytes available in RAM (excluding OS caches)
+//! Return the number of bytes available in RAM (the reclaimable OS
+//! caches counting as available), or left before reaching the memory
+//! limit of the cgroup of the process if that is less.
 uint64_t getFreeRAM();
 
 //! Return the OS username
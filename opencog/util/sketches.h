@@ -0,0 +1,471 @@
+/*
+ * opencog/util/sketches.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_SKETCHES_H
+#define _OPENCOG_SKETCHES_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include <opencog/util/Counter.h>
+#include <opencog/util/oc_assert.h>
+
+namespace opencog {
+/** \addtogroup grp_cogutil
+ *  @{
+ */
+
+/** @name Sketches
+ * Fixed-memory, mergeable approximations of a Counter, for streams
+ * with too many distinct keys to be counted exactly. Each sketch can
+ * be filled per thread and the partial sketches merged afterwards.
+ */
+///@{
+
+/// Finalizer of splitmix64. The hashes produced by boost::hash are
+/// often the identity (for integers, say), so they are scrambled
+/// before being used to index a sketch.
+inline uint64_t sketch_mix(uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * Count-Min sketch (Cormode & Muthukrishnan, 2005).
+ *
+ * Estimates the count of any key using depth x width counters. The
+ * estimate never under-estimates; with width = ceil(e / epsilon) and
+ * depth = ceil(ln(1 / delta)) it over-estimates by more than
+ * epsilon * total_count() with probability at most delta.
+ *
+ * With conservative update (the default) a row is only raised up to
+ * the new minimum estimate, which noticeably reduces the error on
+ * skewed streams. Note that conservative update requires positive
+ * increments.
+ *
+ * Two sketches can only be merged if they have the same dimensions
+ * and seed.
+ */
+template<typename T, typename CT = unsigned, typename Hash = boost::hash<T>>
+class count_min_sketch
+{
+public:
+    count_min_sketch(size_t width, size_t depth,
+                     bool conservative = true, uint64_t seed = 0)
+        : _width(width), _depth(depth), _conservative(conservative),
+          _seed(seed), _total(0), _table(width * depth, CT(0))
+    {
+        OC_ASSERT(width > 0 and depth > 0,
+                  "count_min_sketch: width and depth must be positive");
+    }
+
+    //! Build a sketch whose over-estimation exceeds epsilon *
+    //! total_count() with probability at most delta.
+    static count_min_sketch from_error(double epsilon, double delta,
+                                       bool conservative = true,
+                                       uint64_t seed = 0)
+    {
+        OC_ASSERT(epsilon > 0 and delta > 0 and delta < 1,
+                  "count_min_sketch: invalid error bounds");
+        return count_min_sketch(std::ceil(M_E / epsilon),
+                                std::ceil(std::log(1 / delta)),
+                                conservative, seed);
+    }
+
+    void add(const T& key, CT count = CT(1))
+    {
+        uint64_t h = sketch_mix(_hash(key) ^ _seed);
+        _total += count;
+        if (_conservative) {
+            CT target = estimate_hashed(h) + count;
+            for (size_t row = 0; row < _depth; ++row) {
+                CT& cell = _table[cell_index(row, h)];
+                if (cell < target)
+                    cell = target;
+            }
+        } else {
+            for (size_t row = 0; row < _depth; ++row)
+                _table[cell_index(row, h)] += count;
+        }
+    }
+
+    //! Return an upper bound of the count of key
+    CT estimate(const T& key) const
+    {
+        return estimate_hashed(sketch_mix(_hash(key) ^ _seed));
+    }
+
+    //! Return the total of all counted elements (exact)
+    CT total_count() const
+    {
+        return _total;
+    }
+
+    //! Add the counts of another sketch to this one
+    count_min_sketch& merge(const count_min_sketch& other)
+    {
+        OC_ASSERT(_width == other._width and _depth == other._depth
+                  and _seed == other._seed,
+                  "count_min_sketch: cannot merge sketches of different "
+                  "shapes or seeds");
+        for (size_t i = 0; i < _table.size(); ++i)
+            _table[i] += other._table[i];
+        _total += other._total;
+        return *this;
+    }
+
+    void clear()
+    {
+        std::fill(_table.begin(), _table.end(), CT(0));
+        _total = CT(0);
+    }
+
+    size_t width() const { return _width; }
+    size_t depth() const { return _depth; }
+
+private:
+    // Row hashes are derived by double hashing (Kirsch & Mitzenmacher)
+    // from a single 64-bit hash, which is as good as independent
+    // hashes for this purpose.
+    size_t cell_index(size_t row, uint64_t h) const
+    {
+        uint64_t h1 = h & 0xffffffffULL, h2 = (h >> 32) | 1;
+        return row * _width + (h1 + row * h2) % _width;
+    }
+
+    CT estimate_hashed(uint64_t h) const
+    {
+        CT res = _table[cell_index(0, h)];
+        for (size_t row = 1; row < _depth; ++row)
+            res = std::min(res, _table[cell_index(row, h)]);
+        return res;
+    }
+
+    size_t _width, _depth;
+    bool _conservative;
+    uint64_t _seed;
+    CT _total;
+    std::vector<CT> _table;
+    Hash _hash;
+};
+
+/**
+ * HyperLogLog distinct counter (Flajolet et al., 2007), with the
+ * linear counting correction for small cardinalities.
+ *
+ * Uses 2^precision one-byte registers; the standard error of the
+ * estimate is about 1.04 / sqrt(2^precision), that is 0.8% for the
+ * default precision of 14 (16KB).
+ */
+template<typename T, typename Hash = boost::hash<T>>
+class hyperloglog
+{
+public:
+    hyperloglog(unsigned precision = 14, uint64_t seed = 0)
+        : _precision(precision), _seed(seed),
+          _registers(size_t(1) << precision, 0)
+    {
+        OC_ASSERT(4 <= precision and precision <= 18,
+                  "hyperloglog: precision must be in [4, 18]");
+    }
+
+    void add(const T& key)
+    {
+        uint64_t h = sketch_mix(_hash(key) ^ _seed);
+        size_t idx = h >> (64 - _precision);
+        // Set a sentinel bit so that the rank is bounded by
+        // 64 - precision + 1 even if the remaining bits are all 0.
+        uint64_t w = (h << _precision) | (uint64_t(1) << (_precision - 1));
+        uint8_t rank = __builtin_clzll(w) + 1;
+        if (_registers[idx] < rank)
+            _registers[idx] = rank;
+    }
+
+    //! Return the estimated number of distinct keys added
+    double estimate() const
+    {
+        double m = _registers.size(), sum = 0;
+        size_t zeros = 0;
+        for (uint8_t r : _registers) {
+            sum += std::ldexp(1.0, -r);
+            zeros += r == 0;
+        }
+        double alpha = 0.7213 / (1 + 1.079 / m),
+            e = alpha * m * m / sum;
+        if (e <= 2.5 * m and zeros > 0)
+            return m * std::log(m / zeros);
+        return e;
+    }
+
+    //! Return the relative standard error of estimate()
+    double standard_error() const
+    {
+        return 1.04 / std::sqrt((double)_registers.size());
+    }
+
+    //! Merge another HyperLogLog, the result estimates the
+    //! cardinality of the union of both streams.
+    hyperloglog& merge(const hyperloglog& other)
+    {
+        OC_ASSERT(_precision == other._precision and _seed == other._seed,
+                  "hyperloglog: cannot merge sketches of different "
+                  "precisions or seeds");
+        for (size_t i = 0; i < _registers.size(); ++i)
+            _registers[i] = std::max(_registers[i], other._registers[i]);
+        return *this;
+    }
+
+    void clear()
+    {
+        std::fill(_registers.begin(), _registers.end(), 0);
+    }
+
+    unsigned precision() const { return _precision; }
+
+private:
+    unsigned _precision;
+    uint64_t _seed;
+    std::vector<uint8_t> _registers;
+    Hash _hash;
+};
+
+/**
+ * Space-Saving heavy hitters (Metwally et al., 2005).
+ *
+ * Keeps track of at most capacity keys. Any key whose true count is
+ * larger than total_count() / capacity is guaranteed to be
+ * monitored. The count of a monitored key is over-estimated by at
+ * most its error(), which is also bounded by total_count() / capacity.
+ *
+ * The monitored keys are kept in a min-heap ordered by count so that
+ * an update costs O(log capacity).
+ */
+template<typename T, typename CT = unsigned, typename Hash = boost::hash<T>>
+class space_saving
+{
+public:
+    struct entry {
+        T key;
+        CT count;
+        CT error;
+    };
+
+    space_saving(size_t capacity) : _capacity(capacity), _total(0)
+    {
+        OC_ASSERT(capacity > 0, "space_saving: capacity must be positive");
+        _heap.reserve(capacity);
+        _pos.reserve(capacity);
+    }
+
+    void add(const T& key, CT count = CT(1))
+    {
+        _total += count;
+        auto it = _pos.find(key);
+        if (it != _pos.end()) {
+            _heap[it->second].count += count;
+            sift_down(it->second);
+        } else if (_heap.size() < _capacity) {
+            _pos.emplace(key, _heap.size());
+            _heap.push_back({key, count, CT(0)});
+            sift_up(_heap.size() - 1);
+        } else {
+            // Evict the least frequent key, the newcomer inherits its
+            // count as error.
+            entry& e = _heap.front();
+            _pos.erase(e.key);
+            e.error = e.count;
+            e.count += count;
+            e.key = key;
+            _pos.emplace(key, 0);
+            sift_down(0);
+        }
+    }
+
+    //! Return an upper bound of the count of key. If key is not
+    //! monitored, that bound is the minimum monitored count.
+    CT estimate(const T& key) const
+    {
+        auto it = _pos.find(key);
+        if (it != _pos.end())
+            return _heap[it->second].count;
+        return min_count();
+    }
+
+    //! Return the maximum over-estimation of the count of key
+    CT error(const T& key) const
+    {
+        auto it = _pos.find(key);
+        if (it != _pos.end())
+            return _heap[it->second].error;
+        return min_count();
+    }
+
+    bool contains(const T& key) const
+    {
+        return _pos.find(key) != _pos.end();
+    }
+
+    //! Return the total of all counted elements (exact)
+    CT total_count() const
+    {
+        return _total;
+    }
+
+    size_t size() const { return _heap.size(); }
+    size_t capacity() const { return _capacity; }
+
+    //! Return the k most frequent monitored keys, by decreasing count
+    std::vector<entry> top_k(size_t k) const
+    {
+        std::vector<entry> res(_heap);
+        k = std::min(k, res.size());
+        std::partial_sort(res.begin(), res.begin() + k, res.end(),
+                          [](const entry& l, const entry& r) {
+                              return r.count < l.count; });
+        res.resize(k);
+        return res;
+    }
+
+    //! Return the k most frequent keys (all monitored keys by
+    //! default) and their estimated counts as a Counter.
+    template<typename CMP = std::less<T>>
+    Counter<T, CT, CMP> to_counter(size_t k = SIZE_MAX) const
+    {
+        Counter<T, CT, CMP> res;
+        for (const entry& e : top_k(k))
+            res[e.key] = e.count;
+        return res;
+    }
+
+    /**
+     * Merge another summary into this one (Agarwal et al., Mergeable
+     * Summaries, 2012). A key monitored by only one summary is
+     * assumed to have the other summary's minimum count, which keeps
+     * the estimates upper bounds. Only the capacity largest counts
+     * are retained.
+     */
+    space_saving& merge(const space_saving& other)
+    {
+        CT min_this = min_count(), min_other = other.min_count();
+        std::vector<entry> all;
+        all.reserve(_heap.size() + other._heap.size());
+        for (const entry& e : _heap) {
+            auto it = other._pos.find(e.key);
+            if (it != other._pos.end()) {
+                const entry& o = other._heap[it->second];
+                all.push_back({e.key, e.count + o.count, e.error + o.error});
+            } else {
+                all.push_back({e.key, e.count + min_other,
+                               e.error + min_other});
+            }
+        }
+        for (const entry& o : other._heap)
+            if (_pos.find(o.key) == _pos.end())
+                all.push_back({o.key, o.count + min_this,
+                               o.error + min_this});
+
+        if (all.size() > _capacity) {
+            std::nth_element(all.begin(), all.begin() + _capacity, all.end(),
+                             [](const entry& l, const entry& r) {
+                                 return r.count < l.count; });
+            all.resize(_capacity);
+        }
+
+        _heap = std::move(all);
+        std::make_heap(_heap.begin(), _heap.end(),
+                       [](const entry& l, const entry& r) {
+                           return r.count < l.count; });
+        _pos.clear();
+        for (size_t i = 0; i < _heap.size(); ++i)
+            _pos.emplace(_heap[i].key, i);
+        _total += other._total;
+        return *this;
+    }
+
+    void clear()
+    {
+        _heap.clear();
+        _pos.clear();
+        _total = CT(0);
+    }
+
+private:
+    // The minimum count is only meaningful once the summary is full;
+    // before that, unmonitored keys have never been seen.
+    CT min_count() const
+    {
+        return _heap.size() < _capacity ? CT(0) : _heap.front().count;
+    }
+
+    void swap_entries(size_t i, size_t j)
+    {
+        std::swap(_heap[i], _heap[j]);
+        _pos[_heap[i].key] = i;
+        _pos[_heap[j].key] = j;
+    }
+
+    void sift_up(size_t i)
+    {
+        while (i > 0) {
+            size_t parent = (i - 1) / 2;
+            if (not (_heap[i].count < _heap[parent].count))
+                break;
+            swap_entries(i, parent);
+            i = parent;
+        }
+    }
+
+    void sift_down(size_t i)
+    {
+        size_t n = _heap.size();
+        while (true) {
+            size_t l = 2 * i + 1, r = l + 1, smallest = i;
+            if (l < n and _heap[l].count < _heap[smallest].count)
+                smallest = l;
+            if (r < n and _heap[r].count < _heap[smallest].count)
+                smallest = r;
+            if (smallest == i)
+                break;
+            swap_entries(i, smallest);
+            i = smallest;
+        }
+    }
+
+    size_t _capacity;
+    CT _total;
+    std::vector<entry> _heap;
+    std::unordered_map<T, size_t, Hash> _pos;
+};
+
+///@}
+/** @}*/
+} // ~namespace opencog
+
+#endif // _OPENCOG_SKETCHES_H
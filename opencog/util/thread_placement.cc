@@ -0,0 +1,331 @@
+/*
+ * opencog/util/thread_placement.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include "exceptions.h"
+#include "thread_placement.h"
+
+using namespace opencog;
+
+std::vector<int> opencog::parse_cpu_list(const std::string& list)
+{
+    std::vector<int> res;
+    size_t pos = 0;
+    while (pos < list.size()) {
+        size_t end = list.find(',', pos);
+        if (end == std::string::npos)
+            end = list.size();
+        std::string range = list.substr(pos, end - pos);
+        int first, last;
+        char c;
+        if (sscanf(range.c_str(), "%d-%d%c", &first, &last, &c) == 2) {}
+        else if (sscanf(range.c_str(), "%d%c", &first, &c) == 1)
+            last = first;
+        else
+            throw InvalidParamException(TRACE_INFO,
+                "Invalid CPU list '%s'", list.c_str());
+        if (first < 0 or last < first)
+            throw InvalidParamException(TRACE_INFO,
+                "Invalid CPU range in '%s'", list.c_str());
+        for (int cpu = first; cpu <= last; ++cpu)
+            res.push_back(cpu);
+        pos = end + 1;
+    }
+    std::sort(res.begin(), res.end());
+    res.erase(std::unique(res.begin(), res.end()), res.end());
+    return res;
+}
+
+std::string opencog::format_cpu_list(const std::vector<int>& cpus)
+{
+    std::string res;
+    for (size_t i = 0; i < cpus.size();) {
+        size_t j = i;
+        while (j + 1 < cpus.size() and cpus[j + 1] == cpus[j] + 1)
+            ++j;
+        if (not res.empty())
+            res += ",";
+        res += std::to_string(cpus[i]);
+        if (j > i)
+            res += "-" + std::to_string(cpus[j]);
+        i = j + 1;
+    }
+    return res;
+}
+
+#ifdef __linux__
+
+// CPUs the process is allowed to run on, read when the library is
+// loaded: the affinity of the calling thread would be that of its
+// own placement once it has been placed.
+static const std::vector<int>& process_cpus()
+{
+    static const std::vector<int> cpus = [] {
+        std::vector<int> res;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+                if (CPU_ISSET(cpu, &set))
+                    res.push_back(cpu);
+        }
+        return res;
+    }();
+    return cpus;
+}
+
+static const bool process_cpus_read = (process_cpus(), true);
+
+std::vector<int> opencog::allowed_cpus()
+{
+    return process_cpus();
+}
+
+int opencog::current_cpu()
+{
+    return sched_getcpu();
+}
+
+bool thread_placement::apply(std::thread::native_handle_type th,
+                             unsigned i) const
+{
+    // Anywhere resets the thread to all the allowed CPUs, undoing any
+    // previous placement
+    const std::vector<int>& cs = _kind == ANYWHERE ? process_cpus() : cpus(i);
+    if (cs.empty())
+        return _kind == ANYWHERE;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cs)
+        if (cpu < CPU_SETSIZE)
+            CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(th, sizeof(set), &set) == 0;
+}
+
+#else // __linux__
+
+std::vector<int> opencog::allowed_cpus()
+{
+    std::vector<int> res(std::max(1u, std::thread::hardware_concurrency()));
+    for (size_t i = 0; i < res.size(); ++i)
+        res[i] = i;
+    return res;
+}
+
+int opencog::current_cpu()
+{
+    return -1;
+}
+
+bool thread_placement::apply(std::thread::native_handle_type,
+                             unsigned) const
+{
+    return _kind == ANYWHERE;
+}
+
+#endif // __linux__
+
+bool thread_placement::apply(unsigned i) const
+{
+    return apply(pthread_self(), i);
+}
+
+// Allowed CPUs per NUMA node, nodes without allowed CPUs left out
+static const std::vector<std::vector<int>>& numa_nodes()
+{
+    static const std::vector<std::vector<int>> nodes = [] {
+        std::vector<int> allowed = allowed_cpus();
+        std::vector<std::vector<int>> res;
+        std::string online;
+        std::ifstream in("/sys/devices/system/node/online");
+        if (std::getline(in, online)) {
+            try {
+                for (int node : parse_cpu_list(online)) {
+                    std::ifstream cl("/sys/devices/system/node/node"
+                                     + std::to_string(node) + "/cpulist");
+                    std::string list;
+                    std::getline(cl, list);
+                    std::vector<int> cpus;
+                    for (int cpu : parse_cpu_list(list))
+                        if (std::binary_search(allowed.begin(),
+                                               allowed.end(), cpu))
+                            cpus.push_back(cpu);
+                    if (not cpus.empty())
+                        res.push_back(cpus);
+                }
+            }
+            catch (const InvalidParamException&) {
+                res.clear();
+            }
+        }
+        if (res.empty())
+            res.push_back(allowed);
+        return res;
+    }();
+    return nodes;
+}
+
+unsigned opencog::numa_node_count()
+{
+    return numa_nodes().size();
+}
+
+std::vector<int> opencog::numa_node_cpus(unsigned n)
+{
+    return n < numa_nodes().size() ? numa_nodes()[n] : std::vector<int>();
+}
+
+thread_placement thread_placement::pinned(const std::vector<int>& cpus)
+{
+    if (cpus.empty())
+        throw InvalidParamException(TRACE_INFO,
+            "thread_placement - no CPU to pin to");
+    thread_placement tp;
+    tp._kind = PINNED;
+    tp._cpus.push_back(cpus);
+    std::sort(tp._cpus[0].begin(), tp._cpus[0].end());
+    return tp;
+}
+
+thread_placement thread_placement::spread()
+{
+    return spread(numa_nodes());
+}
+
+thread_placement thread_placement::spread(
+    const std::vector<std::vector<int>>& nodes)
+{
+    if (nodes.empty() or std::any_of(nodes.begin(), nodes.end(),
+                                     [](const std::vector<int>& n) {
+                                         return n.empty(); }))
+        throw InvalidParamException(TRACE_INFO,
+            "thread_placement - empty NUMA node");
+    thread_placement tp;
+    tp._kind = SPREAD;
+    tp._cpus = nodes;
+    return tp;
+}
+
+thread_placement thread_placement::housekeeping()
+{
+    std::vector<int> allowed = allowed_cpus();
+    if (allowed.empty())
+        return thread_placement();
+    return pinned({allowed.back()});
+}
+
+thread_placement thread_placement::parse(const std::string& desc)
+{
+    if (desc == "anywhere" or desc.empty())
+        return thread_placement();
+    if (desc == "spread")
+        return spread();
+    if (desc == "housekeeping")
+        return housekeeping();
+    return pinned(parse_cpu_list(desc));
+}
+
+const std::vector<int>& thread_placement::cpus(unsigned i) const
+{
+    static const std::vector<int> none;
+    if (_cpus.empty())
+        return none;
+    return _cpus[i % _cpus.size()];
+}
+
+std::string thread_placement::to_string() const
+{
+    switch (_kind) {
+    case PINNED:
+        return format_cpu_list(_cpus[0]);
+    case SPREAD:
+        return "spread";
+    default:
+        return "anywhere";
+    }
+}
+
+// Placements per component, initialized from OC_THREAD_PLACEMENT
+struct placement_registry
+{
+    placement_registry()
+    {
+        const char* env = getenv("OC_THREAD_PLACEMENT");
+        std::string spec = env ? env : "";
+        size_t pos = 0;
+        while (pos < spec.size()) {
+            size_t end = spec.find(';', pos);
+            if (end == std::string::npos)
+                end = spec.size();
+            std::string entry = spec.substr(pos, end - pos);
+            pos = end + 1;
+            size_t eq = entry.find('=');
+            if (eq == std::string::npos)
+                continue;
+            // The logger may be the component being placed, so
+            // report errors directly
+            try {
+                placements[entry.substr(0, eq)] =
+                    thread_placement::parse(entry.substr(eq + 1));
+            }
+            catch (const InvalidParamException&) {
+                fprintf(stderr, "Ignoring invalid thread placement '%s' "
+                        "in OC_THREAD_PLACEMENT\n", entry.c_str());
+            }
+        }
+    }
+
+    std::mutex mtx;
+    std::map<std::string, thread_placement> placements;
+};
+
+static placement_registry& registry()
+{
+    static placement_registry reg;
+    return reg;
+}
+
+void opencog::set_thread_placement(const std::string& component,
+                                   const thread_placement& tp)
+{
+    placement_registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mtx);
+    reg.placements[component] = tp;
+}
+
+thread_placement opencog::get_thread_placement(const std::string& component)
+{
+    placement_registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mtx);
+    auto it = reg.placements.find(component);
+    if (it == reg.placements.end())
+        it = reg.placements.find(component.substr(0, component.find('#')));
+    return it == reg.placements.end() ? thread_placement() : it->second;
+}
@@ -0,0 +1,158 @@
+/*
+ * opencog/util/thread_placement.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_THREAD_PLACEMENT_H
+#define _OPENCOG_THREAD_PLACEMENT_H
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace opencog
+{
+/** \addtogroup grp_cogutil
+ *  @{
+ */
+
+/** @name CPU and NUMA topology
+ *
+ * CPUs are numbered as by the kernel. On systems without NUMA
+ * information (or other than Linux) all CPUs are on node 0.
+ */
+///@{
+
+//! CPUs the process is allowed to run on, as when cogutil was loaded
+//! (not restricted by the placement of the calling thread)
+std::vector<int> allowed_cpus();
+
+//! Number of NUMA nodes with CPUs the process is allowed to run on
+unsigned numa_node_count();
+
+//! CPUs of the n-th NUMA node among the numa_node_count() ones, that
+//! the process is allowed to run on
+std::vector<int> numa_node_cpus(unsigned n);
+
+//! CPU the calling thread is running on, -1 if unknown
+int current_cpu();
+
+//! Parse a CPU list in the kernel format, as "0-3,8,10-11". Throw
+//! InvalidParamException if it is not valid.
+std::vector<int> parse_cpu_list(const std::string& list);
+
+//! Format a CPU list in the kernel format
+std::string format_cpu_list(const std::vector<int>& cpus);
+
+///@}
+
+/**
+ * Where the threads of a component (the writers of an async_caller,
+ * the thread of the Logger...) are allowed to run:
+ *
+ * - anywhere (the default): on all the allowed CPUs, undoing any
+ *   previous placement of the thread;
+ *
+ * - pinned: all on a given set of CPUs, for instance a housekeeping
+ *   CPU for the logger, kept away from the compute threads;
+ *
+ * - spread: the i-th thread on the CPUs of the NUMA node i modulo
+ *   the number of nodes, so that each thread stays on one node.
+ *
+ * Threads apply the placement themselves when they start, before
+ * allocating anything, so that with the default first-touch policy
+ * of the kernel the memory they allocate is on their node.
+ *
+ * Placement is best effort: if the CPUs are not available (or the
+ * platform has no affinity support), apply returns false and the
+ * thread runs anywhere.
+ */
+class thread_placement
+{
+public:
+    enum kind { ANYWHERE, PINNED, SPREAD };
+
+    thread_placement() : _kind(ANYWHERE) {}
+
+    static thread_placement pinned(const std::vector<int>& cpus);
+
+    //! Spread over the NUMA nodes of the machine
+    static thread_placement spread();
+
+    //! Spread over the given sets of CPUs, one per node
+    static thread_placement spread(const std::vector<std::vector<int>>& nodes);
+
+    //! Pinned on the last allowed CPU, where housekeeping threads can
+    //! be isolated from the threads using the first ones
+    static thread_placement housekeeping();
+
+    /**
+     * Parse a placement from its description, as in the configuration
+     * or in the OC_THREAD_PLACEMENT environment variable:
+     * "anywhere", "spread", "housekeeping" or a CPU list such as
+     * "0-3,8". Throw InvalidParamException if it is not valid.
+     */
+    static thread_placement parse(const std::string& desc);
+
+    kind get_kind() const { return _kind; }
+
+    //! CPUs of the i-th thread, empty for anywhere
+    const std::vector<int>& cpus(unsigned i) const;
+
+    //! Description, that parse() accepts
+    std::string to_string() const;
+
+    //! Apply the placement of the i-th thread to the given thread.
+    //! Return false if it could not be applied.
+    bool apply(std::thread::native_handle_type th, unsigned i) const;
+
+    //! Apply the placement of the i-th thread to the calling thread
+    bool apply(unsigned i = 0) const;
+
+private:
+    kind _kind;
+    std::vector<std::vector<int>> _cpus;  // per node for SPREAD
+};
+
+/**
+ * Set the placement of the threads of a component, as named in the
+ * metrics registry: "logger", "async_caller", "async_buffer", or the
+ * name of a specific instance such as "async_caller#2", and of the
+ * threads of parallel_run (see oc_omp.h), "parallel_pool". Components
+ * look it up when they start threads.
+ */
+void set_thread_placement(const std::string& component,
+                          const thread_placement& tp);
+
+/**
+ * Placement of the threads of a component: the one set for its name,
+ * else for its name without the instance number, else anywhere.
+ *
+ * Placements are initially read from the OC_THREAD_PLACEMENT
+ * environment variable, a semicolon separated list of
+ * component=description, as in
+ *
+ *     OC_THREAD_PLACEMENT="logger=housekeeping;async_caller=spread"
+ */
+thread_placement get_thread_placement(const std::string& component);
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_THREAD_PLACEMENT_H
@@ -0,0 +1,467 @@
+/*
+ * opencog/util/tracing.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <new>
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "exceptions.h"
+#include "octime.h"
+#include "tracing.h"
+
+using namespace opencog;
+
+namespace opencog
+{
+
+/**
+ * Events of one thread, in a linked list of chunks.
+ *
+ * The owning thread is the only writer: it fills the record at index
+ * _size, then publishes it by a release store of _size + 1 (a new
+ * chunk is linked before that store). Readers load _size with acquire
+ * semantics and only look at the records below it, which are never
+ * modified again. Discarding is done by readers, moving _first.
+ *
+ * Readers hold the mutex of the tracer. The writer only takes it to
+ * unlink the chunks that are entirely discarded, when it needs a new
+ * chunk, so that the capacity applies to the events not discarded
+ * and the memory of the discarded ones is reused.
+ */
+class trace_buffer
+{
+public:
+    static const size_t chunk_size = 1024;
+
+    struct record
+    {
+        const char* name;
+        const char* category;
+        uint64_t start;
+        uint64_t duration;
+        unsigned depth;
+    };
+
+    trace_buffer(long tid, std::mutex& mtx)
+        : tid(tid), depth(0), exited(false), _mtx(mtx),
+          _head(new chunk), _tail(_head), _head_index(0),
+          _size(0), _first(0), _dropped(0) {}
+
+    ~trace_buffer()
+    {
+        for (chunk* c = _head; c;) {
+            chunk* next = c->next.load(std::memory_order_relaxed);
+            delete c;
+            c = next;
+        }
+    }
+
+    // Called by the owning thread only
+    void push(const record& r, const perf_counts& perf, size_t capacity)
+    {
+        size_t n = _size.load(std::memory_order_relaxed);
+        if (n - _first.load(std::memory_order_relaxed) >= capacity) {
+            _dropped.store(_dropped.load(std::memory_order_relaxed) + 1,
+                           std::memory_order_relaxed);
+            return;
+        }
+        size_t i = n % chunk_size;
+        if (i == 0 and n > 0) {
+            chunk* c = reclaim();
+            if (not c)
+                c = new chunk;
+            _tail->next.store(c, std::memory_order_release);
+            _tail = c;
+        }
+        _tail->records[i] = r;
+        if (not perf.empty()) {
+            perf_counts* pc = _tail->perf.load(std::memory_order_relaxed);
+            if (not pc) {
+                pc = new perf_counts[chunk_size];
+                _tail->perf.store(pc, std::memory_order_relaxed);
+            }
+            pc[i] = perf;
+        }
+        _size.store(n + 1, std::memory_order_release);
+    }
+
+    // Call f on each record published and not discarded, with its
+    // counters. The mutex of the tracer must be held.
+    template<typename F>
+    void for_each(F f) const
+    {
+        size_t n = _size.load(std::memory_order_acquire),
+            first = _first.load(std::memory_order_relaxed);
+        const chunk* c = _head;
+        for (size_t i = first - first % chunk_size; i > _head_index;
+             i -= chunk_size)
+            c = c->next.load(std::memory_order_acquire);
+        static const perf_counts no_perf;
+        for (size_t i = first; i < n; ++i) {
+            if (i > first and i % chunk_size == 0)
+                c = c->next.load(std::memory_order_acquire);
+            const perf_counts* pc = c->perf.load(std::memory_order_relaxed);
+            f(c->records[i % chunk_size],
+              pc ? pc[i % chunk_size] : no_perf);
+        }
+    }
+
+    size_t size() const
+    {
+        return _size.load(std::memory_order_acquire)
+            - _first.load(std::memory_order_relaxed);
+    }
+
+    size_t dropped() const
+    {
+        return _dropped.load(std::memory_order_relaxed);
+    }
+
+    // The mutex of the tracer must be held
+    void discard()
+    {
+        _first.store(_size.load(std::memory_order_acquire),
+                     std::memory_order_relaxed);
+    }
+
+    const long tid;
+    std::string name;   // protected by Tracer::_mtx
+    unsigned depth;     // only used by the owning thread
+    bool exited;        // protected by Tracer::_mtx
+
+private:
+    // The counters are in a separate array, only allocated if a span
+    // of the chunk has some, so that events stay small when they are
+    // not recorded
+    struct chunk
+    {
+        ~chunk() { delete[] perf.load(std::memory_order_relaxed); }
+        record records[chunk_size];
+        std::atomic<perf_counts*> perf{nullptr};
+        std::atomic<chunk*> next{nullptr};
+    };
+
+    // Unlink the chunks before _tail that are entirely discarded, and
+    // return one of them for reuse, or nullptr if there is none
+    chunk* reclaim()
+    {
+        if (_first.load(std::memory_order_relaxed) < _head_index + chunk_size)
+            return nullptr;
+        std::lock_guard<std::mutex> lock(_mtx);
+        size_t first = _first.load(std::memory_order_relaxed);
+        chunk* reused = nullptr;
+        while (_head != _tail and _head_index + chunk_size <= first) {
+            chunk* c = _head;
+            _head = c->next.load(std::memory_order_relaxed);
+            _head_index += chunk_size;
+            if (reused)
+                delete c;
+            else
+                reused = c;
+        }
+        if (reused) {
+            reused->next.store(nullptr, std::memory_order_relaxed);
+            delete[] reused->perf.exchange(nullptr, std::memory_order_relaxed);
+        }
+        return reused;
+    }
+
+    std::mutex& _mtx;
+    // _head and _head_index, the index of its first record, are only
+    // modified by the writer with _mtx held
+    chunk* _head;
+    chunk* _tail;
+    size_t _head_index;
+    std::atomic<size_t> _size;
+    std::atomic<size_t> _first;
+    std::atomic<size_t> _dropped;
+};
+
+} // namespace opencog
+
+std::atomic<bool> Tracer::_enabled(false);
+std::atomic<bool> Tracer::_perf_enabled(false);
+
+Tracer::Tracer()
+    : _origin(get_monotonic_nanos()), _capacity(1 << 20),
+      _retired_dropped(0) {}
+
+Tracer::~Tracer()
+{
+    _enabled = false;
+}
+
+Tracer& opencog::tracer()
+{
+    static Tracer instance;
+    return instance;
+}
+
+void Tracer::enable(bool e)
+{
+    _enabled = e;
+}
+
+void Tracer::enable_perf(bool e)
+{
+    _perf_enabled = e;
+}
+
+void Tracer::set_capacity(size_t per_thread)
+{
+    _capacity = per_thread;
+}
+
+uint64_t Tracer::now() const
+{
+    return get_monotonic_nanos() - _origin;
+}
+
+namespace opencog
+{
+
+// Buffer of the calling thread, retired when the thread exits
+struct local_trace_buffer
+{
+    Tracer* tracer = nullptr;
+    trace_buffer* buf = nullptr;
+    ~local_trace_buffer()
+    {
+        if (buf)
+            tracer->retire(buf);
+    }
+};
+
+} // namespace opencog
+
+trace_buffer& Tracer::local_buffer()
+{
+    static thread_local local_trace_buffer local;
+    if (not local.buf) {
+        std::lock_guard<std::mutex> lock(_mtx);
+        _buffers.emplace_back(new trace_buffer(syscall(SYS_gettid), _mtx));
+        local.tracer = this;
+        local.buf = _buffers.back().get();
+    }
+    return *local.buf;
+}
+
+void Tracer::retire(trace_buffer* buf)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    buf->exited = true;
+    // Kept until its events are cleared
+    if (buf->size() == 0)
+        remove_exited();
+}
+
+void Tracer::remove_exited()
+{
+    auto it = std::remove_if(_buffers.begin(), _buffers.end(),
+        [&](const std::unique_ptr<trace_buffer>& buf) {
+            if (not buf->exited or buf->size() > 0)
+                return false;
+            _retired_dropped += buf->dropped();
+            return true;
+        });
+    _buffers.erase(it, _buffers.end());
+}
+
+void Tracer::set_thread_name(const std::string& name)
+{
+    trace_buffer& buf = local_buffer();
+    std::lock_guard<std::mutex> lock(_mtx);
+    buf.name = name;
+}
+
+void Tracer::record(const char* name, const char* category,
+                    uint64_t start_ns, uint64_t end_ns, unsigned depth,
+                    const perf_counts& perf)
+{
+    local_buffer().push({name, category, start_ns,
+                         end_ns > start_ns ? end_ns - start_ns : 0, depth},
+                        perf, _capacity.load(std::memory_order_relaxed));
+}
+
+std::vector<trace_event> Tracer::events() const
+{
+    std::vector<trace_event> res;
+    std::lock_guard<std::mutex> lock(_mtx);
+    for (const auto& buf : _buffers)
+        buf->for_each([&](const trace_buffer::record& r,
+                          const perf_counts& perf) {
+                res.push_back({r.name, r.category, r.start,
+                               r.duration, r.depth, buf->tid, perf});
+            });
+    return res;
+}
+
+size_t Tracer::size() const
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    size_t res = 0;
+    for (const auto& buf : _buffers)
+        res += buf->size();
+    return res;
+}
+
+size_t Tracer::dropped() const
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    size_t res = _retired_dropped;
+    for (const auto& buf : _buffers)
+        res += buf->dropped();
+    return res;
+}
+
+size_t Tracer::n_buffers() const
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _buffers.size();
+}
+
+void Tracer::clear()
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    for (const auto& buf : _buffers)
+        buf->discard();
+    remove_exited();
+}
+
+// Write s as a JSON string
+static void write_json_string(std::ostream& out, const char* s)
+{
+    out << '"';
+    for (; *s; ++s) {
+        unsigned char c = *s;
+        if (c == '"' or c == '\\')
+            out << '\\' << c;
+        else if (c < 0x20)
+            out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                << (unsigned)c << std::dec;
+        else
+            out << c;
+    }
+    out << '"';
+}
+
+// Write nanoseconds as microseconds, the unit of the trace-event format
+static void write_micros(std::ostream& out, uint64_t ns)
+{
+    out << ns / 1000 << '.' << std::setw(3) << std::setfill('0')
+        << ns % 1000;
+}
+
+// Write the counted events as the args of a trace event
+static void write_perf_args(std::ostream& out, const perf_counts& pc)
+{
+    out << ",\"args\":{";
+    const char* sep = "";
+    for (unsigned e = 0; e < perf_counts::N_EVENTS; ++e) {
+        perf_counts::event ev = (perf_counts::event)e;
+        if (pc.has(ev)) {
+            out << sep << '"' << perf_counts::name(ev) << "\":" << pc[ev];
+            sep = ",";
+        }
+    }
+    out << "}";
+}
+
+void Tracer::write_chrome_json(std::ostream& out) const
+{
+    long pid = getpid();
+    std::lock_guard<std::mutex> lock(_mtx);
+    out << "{\"traceEvents\":[";
+    bool first = true;
+    for (const auto& buf : _buffers) {
+        if (not buf->name.empty()) {
+            out << (first ? "\n" : ",\n")
+                << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+                << ",\"tid\":" << buf->tid << ",\"args\":{\"name\":";
+            write_json_string(out, buf->name.c_str());
+            out << "}}";
+            first = false;
+        }
+        buf->for_each([&](const trace_buffer::record& r,
+                          const perf_counts& perf) {
+                out << (first ? "\n" : ",\n") << "{\"name\":";
+                write_json_string(out, r.name);
+                out << ",\"cat\":";
+                write_json_string(out, r.category);
+                out << ",\"ph\":\"X\",\"ts\":";
+                write_micros(out, r.start);
+                out << ",\"dur\":";
+                write_micros(out, r.duration);
+                out << ",\"pid\":" << pid << ",\"tid\":" << buf->tid;
+                if (not perf.empty())
+                    write_perf_args(out, perf);
+                out << "}";
+                first = false;
+            });
+    }
+    size_t n_dropped = _retired_dropped;
+    for (const auto& buf : _buffers)
+        n_dropped += buf->dropped();
+    out << "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped\":"
+        << n_dropped << "}}\n";
+}
+
+void Tracer::save(const std::string& fname) const
+{
+    std::ofstream out(fname);
+    if (not out)
+        throw IOException(TRACE_INFO, "Tracer - cannot open %s",
+                          fname.c_str());
+    write_chrome_json(out);
+    out.close();
+    if (not out)
+        throw IOException(TRACE_INFO, "Tracer - cannot write %s",
+                          fname.c_str());
+}
+
+void trace_span::begin(const char* name, const char* category)
+{
+    _name = name;
+    _category = category;
+    ++tracer().local_buffer().depth;
+    if (Tracer::perf_enabled())
+        new (&_perf_start) perf_counts(local_perf_counters().read());
+    else
+        new (&_perf_start) perf_counts();
+    _start = get_monotonic_nanos();
+}
+
+void trace_span::end()
+{
+    uint64_t end = get_monotonic_nanos();
+    perf_counts perf;
+    if (not _perf_start.empty())
+        perf = local_perf_counters().read() - _perf_start;
+    Tracer& t = tracer();
+    trace_buffer& buf = t.local_buffer();
+    --buf.depth;
+    buf.push({_name, _category, _start - t._origin, end - _start, buf.depth},
+             perf, t._capacity.load(std::memory_order_relaxed));
+}
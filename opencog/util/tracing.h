@@ -0,0 +1,230 @@
+/*
+ * opencog/util/tracing.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_TRACING_H
+#define _OPENCOG_TRACING_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <opencog/util/perf_counters.h>
+
+namespace opencog
+{
+/** \addtogroup grp_cogutil
+ *  @{
+ */
+
+//! A completed span, as returned by Tracer::events()
+struct trace_event
+{
+    const char* name;
+    const char* category;
+    uint64_t start;    // nanoseconds since the tracer was created
+    uint64_t duration; // nanoseconds
+    unsigned depth;    // number of enclosing spans in the same thread
+    long tid;          // kernel thread id
+    perf_counts perf;  // hardware counters, if enabled for the span
+};
+
+class trace_buffer;
+class trace_span;
+
+/**
+ * Process-wide recorder of the spans of all threads.
+ *
+ * Each thread appends its spans to its own buffer, without locking nor
+ * any atomic read-modify-write, so that threads do not contend with
+ * each other, and the buffers can be exported at any time (while other
+ * threads keep recording) in the Chrome trace-event format, to be
+ * viewed with chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Tracing is disabled by default. When disabled a span costs a single
+ * load and branch; when enabled, two reads of the monotonic clock and
+ * the copy of a 40 bytes event.
+ *
+ * Spans can also record the hardware performance counters of their
+ * thread (see perf_counters), exported as the args of the event. This
+ * adds two reads of the counters (a system call each) to every span,
+ * so it is off by default, and meant for coarse spans only. It is
+ * silently ignored where the counters are not available. The counters
+ * are stored aside, in arrays only allocated for chunks of events
+ * that have some, so they cost no memory when not recorded.
+ *
+ * Buffers grow by chunks up to capacity() events per thread, after
+ * which spans are dropped (and counted in dropped()). The memory of
+ * the events discarded by clear() is reused by their thread, so a
+ * process that periodically saves and clears its trace keeps
+ * recording. The buffer of a thread that exited is freed once its
+ * events are cleared.
+ */
+class Tracer
+{
+public:
+    ~Tracer();
+
+    static bool enabled()
+    {
+        return _enabled.load(std::memory_order_relaxed);
+    }
+    void enable(bool e = true);
+    void disable() { enable(false); }
+
+    //! Record the hardware performance counters of each span
+    static bool perf_enabled()
+    {
+        return _perf_enabled.load(std::memory_order_relaxed);
+    }
+    void enable_perf(bool e = true);
+    void disable_perf() { enable_perf(false); }
+
+    //! Maximum number of events recorded per thread
+    void set_capacity(size_t per_thread);
+    size_t capacity() const { return _capacity; }
+
+    //! Name the calling thread in exported traces
+    void set_thread_name(const std::string& name);
+
+    //! Record a span that has been timed by other means, start_ns
+    //! and end_ns being times returned by now(). name and category
+    //! must outlive the tracer (string literals typically).
+    void record(const char* name, const char* category,
+                uint64_t start_ns, uint64_t end_ns, unsigned depth = 0,
+                const perf_counts& perf = perf_counts());
+
+    //! Copy of the events recorded so far, thread by thread, each in
+    //! order of completion
+    std::vector<trace_event> events() const;
+
+    //! Number of events recorded and not cleared
+    size_t size() const;
+
+    //! Number of events dropped because a buffer was full
+    size_t dropped() const;
+
+    //! Number of per-thread buffers
+    size_t n_buffers() const;
+
+    //! Discard the events recorded so far
+    void clear();
+
+    //! Write the events in Chrome trace-event JSON format
+    void write_chrome_json(std::ostream& out) const;
+
+    //! Write the events in Chrome trace-event JSON format to fname,
+    //! throw IOException if it cannot be written
+    void save(const std::string& fname) const;
+
+    //! Nanoseconds since the tracer was created (monotonic clock)
+    uint64_t now() const;
+
+private:
+    Tracer();
+    friend Tracer& tracer();
+    friend class trace_span;
+
+    trace_buffer& local_buffer();
+    friend struct local_trace_buffer;
+    //! Called when the thread of buf exits
+    void retire(trace_buffer* buf);
+    //! Free the buffers of exited threads with no events, _mtx held
+    void remove_exited();
+
+    static std::atomic<bool> _enabled;
+    static std::atomic<bool> _perf_enabled;
+
+    uint64_t _origin;
+    std::atomic<size_t> _capacity;
+    mutable std::mutex _mtx;   // protects _buffers, not their content
+    std::vector<std::unique_ptr<trace_buffer>> _buffers;
+    size_t _retired_dropped;   // dropped by freed buffers
+};
+
+//! Return the process-wide tracer
+Tracer& tracer();
+
+/**
+ * Time the scope it is declared in, if tracing is enabled when it is
+ * constructed. Spans of the same thread nest, like the scopes that
+ * declare them. name and category must outlive the tracer, string
+ * literals typically. Prefer the OC_TRACE_SPAN macro, which can be
+ * compiled out.
+ */
+class trace_span
+{
+public:
+    explicit trace_span(const char* name, const char* category = "")
+        : _name(nullptr)
+    {
+        if (Tracer::enabled())
+            begin(name, category);
+    }
+    ~trace_span()
+    {
+        if (_name)
+            end();
+    }
+
+    trace_span(const trace_span&) = delete;
+    trace_span& operator=(const trace_span&) = delete;
+
+private:
+    void begin(const char* name, const char* category);
+    void end();
+
+    const char* _name;
+    const char* _category;
+    uint64_t _start;
+    // Only constructed by begin(), so that a disabled span does not
+    // zero the counters
+    union { perf_counts _perf_start; };
+};
+
+#define OC_TRACE_CONCAT_(a, b) a ## b
+#define OC_TRACE_CONCAT(a, b) OC_TRACE_CONCAT_(a, b)
+
+/**
+ * Trace the enclosing scope, as in
+ *
+ *     void foo() {
+ *         OC_TRACE_SPAN("foo");
+ *         ...
+ *     }
+ *
+ * Defining OC_DISABLE_TRACING before including this header removes
+ * all spans, not even leaving the enabled() test.
+ */
+#ifdef OC_DISABLE_TRACING
+#define OC_TRACE_SPAN(...)
+#else
+#define OC_TRACE_SPAN(...)                                          \
+    opencog::trace_span OC_TRACE_CONCAT(_oc_trace_span_, __LINE__)(__VA_ARGS__)
+#endif
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_TRACING_H